@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+
+#include "slc/Allocators/Allocator.h"
+#include "slc/Allocators/LinearAllocator.h"
+#include "slc/Allocators/PoolAllocator.h"
+#include "slc/Allocators/StackAllocator.h"
+
+namespace {
+
+	using namespace slc;
+
+	struct Particle
+	{
+		float position[ 3 ];
+		float velocity[ 3 ];
+		float life;
+		uint32_t color;
+	};
+
+	// Each frame fills the allocator and then empties it the way that allocator is meant to be used: a linear
+	// allocator is reset, a pool frees every block and a stack pops in reverse order. The direct variants call the
+	// concrete allocator, so Allocate and Deallocate inline; the virtual ones go through an IAllocator stored
+	// alongside allocators of other types, as a heterogeneous owner would hold them.
+
+	template < typename TAllocator >
+	void LinearFrame( TAllocator& allocator, size_t count )
+	{
+		for ( size_t i = 0; i < count; i++ )
+			Bench::DoNotOptimize( allocator.template Alloc< Particle >() );
+
+		allocator.Reset();
+	}
+
+	template < typename TAllocator >
+	void PoolFrame( TAllocator& allocator, std::vector< Particle* >& live )
+	{
+		for ( auto& particle : live )
+			particle = allocator.template Alloc< Particle >();
+
+		for ( Particle* particle : live )
+			allocator.Free( particle );
+	}
+
+	template < typename TAllocator >
+	void StackFrame( TAllocator& allocator, std::vector< void* >& live )
+	{
+		for ( size_t i = 0; i < live.size(); i++ )
+			live[ i ] = allocator.Allocate( 16 + i % 4 * 16 );
+
+		for ( size_t i = live.size(); i-- > 0; )
+			allocator.Deallocate( live[ i ] );
+	}
+
+	void PrintRow( std::string_view allocator, double directNs, double virtualNs )
+	{
+		Bench::Print( "{:<10} {:>10.2f} {:>10.2f} {:>8.2f}x", allocator, directNs, virtualNs, virtualNs / directNs );
+	}
+} // namespace
+
+SLC_BENCHMARK( AllocatorDispatch, "Direct allocator calls against the virtual IAllocator path" )
+{
+	const size_t count = args.GetOr( "count", 4096 );
+	const size_t frames = args.GetOr( "frames", 200 );
+	const auto perOp = [ count ]( double frameNs ) { return frameNs / static_cast< double >( count ); };
+
+	LinearAllocator< Particle > linear( count );
+	PoolAllocator< Particle > pool( count );
+	StackAllocator stack( count * 96 );
+
+	std::vector< Unique< IAllocator > > erased;
+	erased.push_back( MakeUnique< AllocatorAdapter< LinearAllocator< Particle > > >( count ) );
+	erased.push_back( MakeUnique< AllocatorAdapter< PoolAllocator< Particle > > >( count ) );
+	erased.push_back( MakeUnique< AllocatorAdapter< StackAllocator > >( count * 96 ) );
+
+	std::vector< Particle* > particles( count );
+	std::vector< void* > blocks( count );
+
+	Bench::Print( "{} allocations per frame. ns per allocation, including its share of the free or reset.", count );
+	Bench::Print( "{:<10} {:>10} {:>10} {:>9}", "allocator", "direct", "virtual", "ratio" );
+
+	PrintRow( "Linear", perOp( Bench::TimePerCall( frames, [ & ] { LinearFrame( linear, count ); } ) ),
+			  perOp( Bench::TimePerCall( frames, [ & ] { LinearFrame( *erased[ 0 ], count ); } ) ) );
+	PrintRow( "Pool", perOp( Bench::TimePerCall( frames, [ & ] { PoolFrame( pool, particles ); } ) ),
+			  perOp( Bench::TimePerCall( frames, [ & ] { PoolFrame( *erased[ 1 ], particles ); } ) ) );
+	PrintRow( "Stack", perOp( Bench::TimePerCall( frames, [ & ] { StackFrame( stack, blocks ); } ) ),
+			  perOp( Bench::TimePerCall( frames, [ & ] { StackFrame( *erased[ 2 ], blocks ); } ) ) );
+}
@@ -0,0 +1,66 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace slc::Bench {
+
+	Arguments::Arguments( int argc, char** argv )
+	{
+		for ( int i = 1; i < argc; i++ )
+		{
+			std::string_view arg = argv[ i ];
+			if ( arg.starts_with( "--" ) )
+			{
+				std::string_view value = i + 1 < argc && !std::string_view( argv[ i + 1 ] ).starts_with( "--" ) ? argv[ ++i ] : "";
+				mOptions.emplace_back( arg.substr( 2 ), value );
+			}
+			else
+			{
+				mFilters.push_back( arg );
+			}
+		}
+	}
+
+	std::optional< std::string_view > Arguments::Get( std::string_view name ) const
+	{
+		auto it = std::ranges::find( mOptions, name, &std::pair< std::string_view, std::string_view >::first );
+		if ( it == mOptions.end() )
+			return std::nullopt;
+
+		return it->second;
+	}
+
+	size_t Arguments::GetOr( std::string_view name, size_t fallback ) const
+	{
+		auto value = Get( name );
+		if ( !value )
+			return fallback;
+
+		size_t result = fallback;
+		std::from_chars( value->data(), value->data() + value->size(), result );
+		return result;
+	}
+
+	bool Arguments::Selects( std::string_view benchmark ) const
+	{
+		return mFilters.empty() || std::ranges::any_of( mFilters, [ benchmark ]( std::string_view filter ) { return benchmark.contains( filter ); } );
+	}
+
+	std::vector< Benchmark >& GetRegistry()
+	{
+		static std::vector< Benchmark > sRegistry;
+		return sRegistry;
+	}
+
+	Percentiles ComputePercentiles( std::vector< double >& samples )
+	{
+		if ( samples.empty() )
+			return {};
+
+		std::ranges::sort( samples );
+		auto at = [ & ]( double quantile ) { return samples[ std::min( samples.size() - 1, static_cast< size_t >( quantile * static_cast< double >( samples.size() ) ) ) ]; };
+
+		return { at( 0.5 ), at( 0.99 ), at( 0.999 ), samples.back() };
+	}
+} // namespace slc::Bench
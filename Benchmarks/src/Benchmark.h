@@ -0,0 +1,115 @@
+#pragma once
+
+#include "slc/Common/Base.h"
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace slc::Bench {
+
+	using Clock = std::chrono::steady_clock;
+
+	/// <summary>
+	/// Command line of the benchmark binary. Options are given as --name value and shared by every benchmark;
+	/// any other argument selects the benchmarks whose name contains it.
+	/// </summary>
+	class Arguments
+	{
+	public:
+		Arguments( int argc, char** argv );
+
+		std::optional< std::string_view > Get( std::string_view name ) const;
+		size_t GetOr( std::string_view name, size_t fallback ) const;
+
+		bool Has( std::string_view name ) const
+		{
+			return Get( name ).has_value();
+		}
+
+		bool Selects( std::string_view benchmark ) const;
+
+	private:
+		std::vector< std::pair< std::string_view, std::string_view > > mOptions;
+		std::vector< std::string_view > mFilters;
+	};
+
+	using BenchmarkFunction = void ( * )( const Arguments& args );
+
+	struct Benchmark
+	{
+		std::string_view name;
+		std::string_view description;
+		BenchmarkFunction run;
+	};
+
+	std::vector< Benchmark >& GetRegistry();
+
+	struct Registrar
+	{
+		Registrar( std::string_view name, std::string_view description, BenchmarkFunction run )
+		{
+			GetRegistry().push_back( { name, description, run } );
+		}
+	};
+
+	/// <summary>
+	/// Keep the compiler from discarding a result that is otherwise unused.
+	/// </summary>
+	template < typename T >
+	void DoNotOptimize( const T& value )
+	{
+		static const void* volatile sSink;
+		sSink = &value;
+	}
+
+	/// <summary>
+	/// Nanoseconds per call of func, taking the fastest of several runs of the given number of calls.
+	/// </summary>
+	template < typename Func >
+	double TimePerCall( size_t iterations, Func&& func, size_t runs = 5 )
+	{
+		double best = std::numeric_limits< double >::max();
+		for ( size_t run = 0; run < runs; run++ )
+		{
+			auto start = Clock::now();
+			for ( size_t i = 0; i < iterations; i++ )
+				func();
+			std::chrono::duration< double, std::nano > elapsed = Clock::now() - start;
+
+			best = std::min( best, elapsed.count() / static_cast< double >( iterations ) );
+		}
+
+		return best;
+	}
+
+	struct Percentiles
+	{
+		double p50{};
+		double p99{};
+		double p999{};
+		double max{};
+	};
+
+	/// <summary>
+	/// Sorts the samples in place.
+	/// </summary>
+	Percentiles ComputePercentiles( std::vector< double >& samples );
+
+	template < typename... Args >
+	void Print( std::format_string< Args... > message, Args&&... args )
+	{
+		std::cout << std::format( message, std::forward< Args >( args )... ) << '\n';
+	}
+} // namespace slc::Bench
+
+/// <summary>
+/// Define and register a benchmark. The body receives the command line as args.
+/// </summary>
+#define SLC_BENCHMARK( name, description )                                                    \
+	static void name( const ::slc::Bench::Arguments& args );                                  \
+	static const ::slc::Bench::Registrar name##Registrar( #name, description, &name );        \
+	static void name( [[maybe_unused]] const ::slc::Bench::Arguments& args )
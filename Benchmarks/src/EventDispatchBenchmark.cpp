@@ -0,0 +1,125 @@
+#include "Benchmark.h"
+
+#include "slc/Events/IEventListener.h"
+#include "slc/Events/KeyEvent.h"
+#include "slc/Events/MouseEvent.h"
+
+namespace {
+
+	using namespace slc;
+
+	// Handles one or two input event types, as most gameplay and UI listeners do.
+	class InputListener final : public IEventListener
+	{
+	public:
+		InputListener( EventTypeFlag events )
+			: mEvents( events )
+		{}
+
+		EventTypeFlag GetListeningEvents() const override
+		{
+			return mEvents;
+		}
+
+		void OnEvent( Event& e ) override
+		{
+			e.Dispatch< KeyPressedEvent >( [ this ]( KeyPressedEvent& event ) {
+				mChecksum += static_cast< uint64_t >( event.keyCode );
+				return false;
+			} );
+			e.Dispatch< MouseButtonPressedEvent >( [ this ]( MouseButtonPressedEvent& event ) {
+				mChecksum += static_cast< uint64_t >( event.button );
+				return false;
+			} );
+
+			mCalls++;
+		}
+
+		uint64_t GetCalls() const
+		{
+			return mCalls;
+		}
+
+		uint64_t GetChecksum() const
+		{
+			return mChecksum;
+		}
+
+	private:
+		EventTypeFlag mEvents;
+		uint64_t mCalls = 0;
+		uint64_t mChecksum = 0;
+	};
+
+	// Only event types that keep every instance, so coalescing does not shrink the frame.
+	void PostFrame( size_t events )
+	{
+		for ( size_t i = 0; i < events; i++ )
+		{
+			const int code = static_cast< int >( i % 64 );
+			switch ( i % 5 )
+			{
+				case 0: EventManager::Post< KeyPressedEvent >( code, false ); break;
+				case 1: EventManager::Post< KeyReleasedEvent >( code ); break;
+				case 2: EventManager::Post< KeyTypedEvent >( code ); break;
+				case 3: EventManager::Post< MouseButtonPressedEvent >( code % 8 ); break;
+				case 4: EventManager::Post< MouseButtonReleasedEvent >( code % 8 ); break;
+			}
+		}
+	}
+} // namespace
+
+SLC_BENCHMARK( EventDispatch, "Dispatch a frame of 10k input events to 1k listeners" )
+{
+	const size_t listenerCount = args.GetOr( "listeners", 1000 );
+	const size_t events = args.GetOr( "events", 10'000 );
+	const size_t frames = args.GetOr( "frames", 100 );
+
+	const EventTypeFlag masks[] = {
+		EventType::KeyPressed,
+		EventType::KeyPressed | EventType::KeyReleased,
+		EventType::KeyTyped,
+		EventType::MouseButtonPressed,
+		EventType::MouseButtonPressed | EventType::MouseButtonReleased,
+		EventType::MouseMoved,
+		EventType::WindowResize,
+	};
+
+	std::vector< Unique< InputListener > > listeners;
+	for ( size_t i = 0; i < listenerCount; i++ )
+		listeners.push_back( MakeUnique< InputListener >( masks[ i % std::size( masks ) ] ) );
+
+	// Apply the registrations before timing anything.
+	EventManager::Dispatch();
+
+	std::vector< double > postSamples, dispatchSamples;
+	for ( size_t frame = 0; frame < frames; frame++ )
+	{
+		auto start = Bench::Clock::now();
+		PostFrame( events );
+		auto posted = Bench::Clock::now();
+		EventManager::Dispatch();
+		auto dispatched = Bench::Clock::now();
+
+		postSamples.push_back( std::chrono::duration< double, std::micro >( posted - start ).count() );
+		dispatchSamples.push_back( std::chrono::duration< double, std::micro >( dispatched - posted ).count() );
+	}
+
+	uint64_t calls = 0, checksum = 0;
+	for ( const auto& listener : listeners )
+	{
+		calls += listener->GetCalls();
+		checksum += listener->GetChecksum();
+	}
+	Bench::DoNotOptimize( checksum );
+
+	const double callsPerFrame = static_cast< double >( calls ) / static_cast< double >( frames );
+	Bench::Print( "{} listeners, {} events and {:.0f} listener calls per frame, {} frames", listenerCount, events, callsPerFrame, frames );
+	Bench::Print( "{:<10} {:>10} {:>10} {:>10} {:>10}", "us/frame", "p50", "p99", "p99.9", "max" );
+
+	Bench::Percentiles post = Bench::ComputePercentiles( postSamples );
+	Bench::Percentiles dispatch = Bench::ComputePercentiles( dispatchSamples );
+	Bench::Print( "{:<10} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}", "post", post.p50, post.p99, post.p999, post.max );
+	Bench::Print( "{:<10} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}", "dispatch", dispatch.p50, dispatch.p99, dispatch.p999, dispatch.max );
+	Bench::Print( "ns per listener call at p50: {:.2f}", dispatch.p50 * 1000.0 / callsPerFrame );
+}
@@ -0,0 +1,180 @@
+#include "Benchmark.h"
+
+#include "slc/Events/ApplicationEvent.h"
+#include "slc/Events/EventRecorder.h"
+#include "slc/Events/IEventListener.h"
+#include "slc/Events/KeyEvent.h"
+#include "slc/Events/MouseEvent.h"
+#include "slc/Types/Timestep.h"
+
+#include <cmath>
+
+namespace {
+
+	using namespace slc;
+
+	/// <summary>
+	/// Stands in for an application layer: handles the events it listens for and does a little work per update.
+	/// </summary>
+	class TraceLayer final : public IEventListener
+	{
+	public:
+		TraceLayer( EventTypeFlag events )
+			: mEvents( events )
+		{}
+
+		EventTypeFlag GetListeningEvents() const override
+		{
+			return mEvents;
+		}
+
+		void OnEvent( Event& e ) override
+		{
+			e.Dispatch< MouseMovedEvent >( [ this ]( MouseMovedEvent& event ) {
+				mCursor = { event.mouseX, event.mouseY };
+				return false;
+			} );
+			e.Dispatch< MouseScrolledEvent >( [ this ]( MouseScrolledEvent& event ) {
+				mZoom += event.yOffset;
+				return false;
+			} );
+			e.Dispatch< KeyPressedEvent >( [ this ]( KeyPressedEvent& event ) {
+				mChecksum += static_cast< uint64_t >( event.keyCode );
+				return false;
+			} );
+			e.Dispatch< WindowResizeEvent >( [ this ]( WindowResizeEvent& event ) {
+				mChecksum += event.width * event.height;
+				return false;
+			} );
+
+			mEventCount++;
+		}
+
+		void OnUpdate( Timestep ts )
+		{
+			mZoom *= 1.0f - 0.1f * ts.GetSeconds();
+			mChecksum += static_cast< uint64_t >( mCursor.first + mCursor.second );
+		}
+
+		uint64_t GetEventCount() const
+		{
+			return mEventCount;
+		}
+
+		uint64_t GetChecksum() const
+		{
+			return mChecksum + static_cast< uint64_t >( mZoom );
+		}
+
+	private:
+		EventTypeFlag mEvents;
+		std::pair< float, float > mCursor{};
+		float mZoom = 1.0f;
+		uint64_t mEventCount = 0;
+		uint64_t mChecksum = 0;
+	};
+
+	// A rough stand-in for a real session: constant mouse movement, occasional scrolling and typing, and rare resizes.
+	void RecordSyntheticTrace( const fs::path& path, size_t frames )
+	{
+		EventRecorder recorder( path );
+		recorder.Start();
+
+		for ( size_t frame = 0; frame < frames; frame++ )
+		{
+			const float t = static_cast< float >( frame );
+			for ( int i = 0; i < 8; i++ )
+				EventManager::Post< MouseMovedEvent >( 800.0f + 300.0f * std::sin( t * 0.01f + i ), 450.0f + 200.0f * std::cos( t * 0.013f + i ) );
+
+			if ( frame % 3 == 0 )
+				EventManager::Post< MouseScrolledEvent >( 0.0f, 1.0f );
+			if ( frame % 5 == 0 )
+				EventManager::Post< KeyPressedEvent >( static_cast< KeyCode >( 65 + frame % 26 ), false );
+			if ( frame % 500 == 0 )
+				EventManager::Post< WindowResizeEvent >( 1600u + static_cast< unsigned >( frame % 7 ), 900u );
+
+			EventManager::Dispatch();
+		}
+
+		recorder.Stop();
+	}
+} // namespace
+
+SLC_BENCHMARK( EventReplay, "Replay an event trace through listeners: post, dispatch and update cost per frame" )
+{
+	// --trace <file> replays a recorded trace; without it a synthetic one is recorded first.
+	fs::path tracePath;
+	if ( auto trace = args.Get( "trace" ) )
+	{
+		tracePath = *trace;
+	}
+	else
+	{
+		tracePath = fs::temp_directory_path() / "slc_bench_trace.slcev";
+		RecordSyntheticTrace( tracePath, args.GetOr( "frames", 2000 ) );
+	}
+
+	EventReplayer replayer( tracePath );
+	if ( !replayer.IsValid() )
+	{
+		Bench::Print( "Could not read trace {}", tracePath.string() );
+		return;
+	}
+
+	const size_t layerCount = args.GetOr( "layers", 16 );
+	const size_t passes = args.GetOr( "passes", 5 );
+
+	const EventTypeFlag masks[] = {
+		EventType::MouseMoved | EventType::MouseScrolled,
+		EventType::KeyPressed | EventType::KeyReleased | EventType::KeyTyped,
+		EventType::WindowResize | EventType::MouseMoved,
+		EventType::MouseMoved | EventType::MouseScrolled | EventType::KeyPressed | EventType::WindowResize,
+	};
+
+	std::vector< Unique< TraceLayer > > layers;
+	for ( size_t i = 0; i < layerCount; i++ )
+		layers.push_back( MakeUnique< TraceLayer >( masks[ i % std::size( masks ) ] ) );
+
+	// Apply the registrations before timing anything.
+	EventManager::Dispatch();
+
+	std::vector< double > postSamples, dispatchSamples, updateSamples;
+	for ( size_t pass = 0; pass < passes; pass++ )
+	{
+		replayer.Restart();
+		while ( true )
+		{
+			auto start = Bench::Clock::now();
+			if ( !replayer.ReplayFrame() )
+				break;
+			auto posted = Bench::Clock::now();
+			EventManager::Dispatch();
+			auto dispatched = Bench::Clock::now();
+			for ( auto& layer : layers )
+				layer->OnUpdate( 1.0f / 60.0f );
+			auto updated = Bench::Clock::now();
+
+			postSamples.push_back( std::chrono::duration< double, std::micro >( posted - start ).count() );
+			dispatchSamples.push_back( std::chrono::duration< double, std::micro >( dispatched - posted ).count() );
+			updateSamples.push_back( std::chrono::duration< double, std::micro >( updated - dispatched ).count() );
+		}
+	}
+
+	uint64_t handled = 0, checksum = 0;
+	for ( const auto& layer : layers )
+	{
+		handled += layer->GetEventCount();
+		checksum += layer->GetChecksum();
+	}
+	Bench::DoNotOptimize( checksum );
+
+	Bench::Print( "trace {}: {} frames, {} layers, {} passes, {} events skipped", tracePath.string(), replayer.GetFrameCount(), layerCount, passes, replayer.GetSkippedCount() );
+	Bench::Print( "listener calls per frame: {:.1f}", static_cast< double >( handled ) / static_cast< double >( dispatchSamples.size() ) );
+	Bench::Print( "{:<10} {:>10} {:>10} {:>10} {:>10}", "us/frame", "p50", "p99", "p99.9", "max" );
+
+	for ( auto& [ label, samples ] : { std::pair{ "post", &postSamples }, std::pair{ "dispatch", &dispatchSamples }, std::pair{ "update", &updateSamples } } )
+	{
+		Bench::Percentiles percentiles = Bench::ComputePercentiles( *samples );
+		Bench::Print( "{:<10} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f}", label, percentiles.p50, percentiles.p99, percentiles.p999, percentiles.max );
+	}
+}
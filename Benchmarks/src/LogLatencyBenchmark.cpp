@@ -0,0 +1,94 @@
+#include "Benchmark.h"
+
+#include "slc/Logging/Logger.h"
+#include "slc/Logging/Targets/FileLogTarget.h"
+
+#include <latch>
+#include <thread>
+
+namespace {
+
+	using namespace slc;
+
+#ifdef SLC_PLATFORM_WINDOWS
+	constexpr std::string_view NullDevice = "NUL";
+#else
+	constexpr std::string_view NullDevice = "/dev/null";
+#endif
+
+	struct LatencyResult
+	{
+		Bench::Percentiles latency;
+		double elapsedMs{};
+		size_t ringFullWaits{};
+	};
+
+	// Every thread logs its messages as fast as it can, timing each Log call. The target writes to the null
+	// device, so what is measured is the producer side: formatting into the ring and waiting when it is full.
+	LatencyResult MeasureLatency( size_t threads, size_t messages, const std::string& output )
+	{
+		std::vector< std::vector< double > > samples( threads );
+		LatencyResult result;
+
+		auto start = Bench::Clock::now();
+		{
+			Logger logger;
+			logger.AddLogTarget< FileLogTarget >( output, LogLevel::Info );
+
+			std::latch ready( static_cast< std::ptrdiff_t >( threads ) );
+			std::vector< std::thread > producers;
+			for ( size_t thread = 0; thread < threads; thread++ )
+			{
+				producers.emplace_back( [ &, thread ] {
+					auto& latencies = samples[ thread ];
+					latencies.reserve( messages );
+					ready.arrive_and_wait();
+
+					for ( size_t i = 0; i < messages; i++ )
+					{
+						auto before = Bench::Clock::now();
+						logger.Log( LogLevel::Info, "Thread {} message {} value {:.3f}", thread, i, static_cast< double >( i ) * 0.5 );
+						std::chrono::duration< double, std::nano > latency = Bench::Clock::now() - before;
+						latencies.push_back( latency.count() );
+					}
+				} );
+			}
+
+			for ( auto& producer : producers )
+				producer.join();
+
+			result.ringFullWaits = logger.GetStats().ring_full_waits;
+		}
+		std::chrono::duration< double, std::milli > elapsed = Bench::Clock::now() - start;
+		result.elapsedMs = elapsed.count();
+
+		std::vector< double > all;
+		all.reserve( threads * messages );
+		for ( auto& latencies : samples )
+			all.insert( all.end(), latencies.begin(), latencies.end() );
+
+		result.latency = Bench::ComputePercentiles( all );
+		return result;
+	}
+} // namespace
+
+SLC_BENCHMARK( LogLatency, "Per-call Logger::Log latency with 1, 8 and 32 producer threads" )
+{
+	const size_t messages = args.GetOr( "messages", 100'000 );
+	const std::string output( args.Get( "output" ).value_or( NullDevice ) );
+
+	// --threads runs a single configuration instead of the default sweep.
+	std::vector< size_t > threadCounts = { 1, 8, 32 };
+	if ( args.Has( "threads" ) )
+		threadCounts = { args.GetOr( "threads", 1 ) };
+
+	Bench::Print( "{} messages per thread, written to {}. Latencies in ns and include two clock reads.", messages, output );
+	Bench::Print( "{:>8} {:>10} {:>10} {:>10} {:>12} {:>12} {:>12}", "threads", "p50", "p99", "p999", "max", "ring waits", "total ms" );
+
+	for ( size_t threads : threadCounts )
+	{
+		auto result = MeasureLatency( threads, messages, output );
+		Bench::Print( "{:>8} {:>10.0f} {:>10.0f} {:>10.0f} {:>12.0f} {:>12} {:>12.1f}", threads, result.latency.p50, result.latency.p99, result.latency.p999, result.latency.max,
+					  result.ringFullWaits, result.elapsedMs );
+	}
+}
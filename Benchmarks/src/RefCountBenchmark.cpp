@@ -0,0 +1,104 @@
+#include "Benchmark.h"
+
+#include "slc/Common/Memory.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+	using namespace slc;
+
+	struct SharedObject : RefCounted
+	{
+		uint64_t value = 0;
+	};
+
+	struct LocalObject : LocalRefCounted
+	{
+		uint64_t value = 0;
+	};
+
+	// A copy bumps the count and the destructor drops it again.
+	template < typename T >
+	double CopyAndRelease( size_t iterations )
+	{
+		auto source = Ref< T >::Create();
+		return Bench::TimePerCall( iterations, [ & ] {
+			Ref< T > copy = source;
+			Bench::DoNotOptimize( copy );
+		} );
+	}
+
+	// Moves hand the pointer over and leave the count alone.
+	template < typename T >
+	double MoveRoundTrip( size_t iterations )
+	{
+		auto source = Ref< T >::Create();
+		return Bench::TimePerCall( iterations, [ & ] {
+			Ref< T > moved = std::move( source );
+			Bench::DoNotOptimize( moved );
+			source = std::move( moved );
+		} );
+	}
+
+	// Reordering a container of references, as sorting or compacting a list of owned resources does.
+	template < typename T >
+	double RotateContainer( size_t iterations, size_t count )
+	{
+		std::vector< Ref< T > > refs;
+		for ( size_t i = 0; i < count; i++ )
+			refs.push_back( Ref< T >::Create() );
+
+		double perCall = Bench::TimePerCall( iterations, [ & ] { std::rotate( refs.begin(), refs.begin() + 1, refs.end() ); } );
+		return perCall / static_cast< double >( count );
+	}
+
+	// Several threads copying references to the same object all write to one counter.
+	double ContendedCopies( size_t iterations, size_t threads )
+	{
+		auto source = Ref< SharedObject >::Create();
+
+		auto start = Bench::Clock::now();
+		std::vector< std::thread > workers;
+		for ( size_t thread = 0; thread < threads; thread++ )
+		{
+			workers.emplace_back( [ & ] {
+				for ( size_t i = 0; i < iterations; i++ )
+				{
+					Ref< SharedObject > copy = source;
+					Bench::DoNotOptimize( copy );
+				}
+			} );
+		}
+
+		for ( auto& worker : workers )
+			worker.join();
+
+		std::chrono::duration< double, std::nano > elapsed = Bench::Clock::now() - start;
+		return elapsed.count() / static_cast< double >( iterations );
+	}
+
+	void PrintRow( std::string_view operation, double atomicNs, double localNs )
+	{
+		Bench::Print( "{:<26} {:>10.2f} {:>10.2f}", operation, atomicNs, localNs );
+	}
+} // namespace
+
+SLC_BENCHMARK( RefCount, "Ref copies and moves under the atomic and single threaded count policies" )
+{
+	const size_t iterations = args.GetOr( "iterations", 10'000'000 );
+	const size_t count = args.GetOr( "count", 1024 );
+	const size_t threads = args.GetOr( "threads", std::max( 2u, std::thread::hardware_concurrency() ) );
+
+	Bench::Print( "ns per operation. RefCounted counts atomically, LocalRefCounted with plain arithmetic." );
+	Bench::Print( "{:<26} {:>10} {:>10}", "operation", "atomic", "local" );
+
+	PrintRow( "copy and release", CopyAndRelease< SharedObject >( iterations ), CopyAndRelease< LocalObject >( iterations ) );
+	PrintRow( "move there and back", MoveRoundTrip< SharedObject >( iterations ), MoveRoundTrip< LocalObject >( iterations ) );
+	PrintRow( "rotate vector, per element", RotateContainer< SharedObject >( iterations / count, count ),
+			  RotateContainer< LocalObject >( iterations / count, count ) );
+
+	// Wall time per iteration with every thread running, so the cost of sharing the counter shows up directly.
+	Bench::Print( "copy and release on {} threads sharing one object: {:.2f} ns", threads, ContendedCopies( iterations / threads, threads ) );
+}
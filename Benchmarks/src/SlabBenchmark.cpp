@@ -0,0 +1,184 @@
+#include "Benchmark.h"
+
+#include "slc/Allocators/SlabAllocator.h"
+#include "slc/Common/Memory.h"
+#include "slc/Events/Event.h"
+#include "slc/Events/MouseEvent.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+
+	using namespace slc;
+
+	// A typical small shared object: a handful of fields behind a Ref.
+	struct SharedComponent : RefCounted
+	{
+		float transform[ 8 ]{};
+		uint32_t flags = 0;
+	};
+
+	// Captures of the size the framework's std::function jobs and callbacks carry. Anything over the 16 bytes
+	// std::function stores inline goes to operator new.
+	struct JobCapture
+	{
+		Ref< SharedComponent > component;
+		void* owner;
+		double time;
+		uint64_t frame;
+	};
+
+	struct CallbackCapture
+	{
+		std::string name;
+		std::function< void() >* next;
+		uint32_t id;
+	};
+
+	struct MallocHeap
+	{
+		static void* Allocate( std::size_t size )
+		{
+			return std::malloc( size );
+		}
+
+		static void Deallocate( void* ptr, std::size_t )
+		{
+			std::free( ptr );
+		}
+	};
+
+	struct SlabHeap
+	{
+		static void* Allocate( std::size_t size )
+		{
+			return SlabAllocator::Allocate( size );
+		}
+
+		static void Deallocate( void* ptr, std::size_t size )
+		{
+			SlabAllocator::Deallocate( ptr, size );
+		}
+	};
+
+	// Fixed shuffled order, so both heaps free in the same pattern.
+	std::vector< size_t > ShuffledIndices( size_t count )
+	{
+		std::vector< size_t > indices( count );
+		std::iota( indices.begin(), indices.end(), size_t{ 0 } );
+		std::shuffle( indices.begin(), indices.end(), std::mt19937( 1234 ) );
+		return indices;
+	}
+
+	// Events that overflow the frame's model arena are heap allocated when posted and all freed after dispatch.
+	template < typename THeap >
+	double EventOverflowFrame( size_t count )
+	{
+		using Model = EventModel< MouseMovedEvent >;
+		std::vector< Model* > models( count );
+
+		double perFrame = Bench::TimePerCall( 50, [ & ] {
+			for ( size_t i = 0; i < count; i++ )
+				models[ i ] = new ( THeap::Allocate( sizeof( Model ) ) ) Model( static_cast< float >( i ), 1.0f );
+
+			for ( Model* model : models )
+			{
+				model->~Model();
+				THeap::Deallocate( model, sizeof( Model ) );
+			}
+		} );
+
+		return perFrame / static_cast< double >( count );
+	}
+
+	// Long lived objects created together and released in no particular order.
+	template < typename Func >
+	double RefObjects( size_t count, Func&& create )
+	{
+		auto order = ShuffledIndices( count );
+		std::vector< Ref< SharedComponent > > objects( count );
+
+		double perFrame = Bench::TimePerCall( 50, [ & ] {
+			for ( auto& object : objects )
+				object = create();
+
+			for ( size_t index : order )
+				objects[ index ] = nullptr;
+		} );
+
+		return perFrame / static_cast< double >( count );
+	}
+
+	// Job captures are allocated where the job is submitted and freed by the worker that ran it.
+	template < typename THeap, typename TCapture >
+	double CrossThreadCaptures( size_t count )
+	{
+		std::vector< void* > batch( count );
+		// Odd while the worker owns the batch, even while the submitting thread does.
+		std::atomic_uint32_t phase = 0;
+		std::atomic_bool stop = false;
+
+		std::thread worker( [ & ] {
+			uint32_t seen = 0;
+			while ( true )
+			{
+				phase.wait( seen );
+				if ( stop.load() )
+					break;
+
+				for ( void* capture : batch )
+					THeap::Deallocate( capture, sizeof( TCapture ) );
+
+				seen = phase.fetch_add( 1 ) + 1;
+				phase.notify_one();
+			}
+		} );
+
+		double perFrame = Bench::TimePerCall( 50, [ & ] {
+			for ( void*& capture : batch )
+				capture = THeap::Allocate( sizeof( TCapture ) );
+
+			uint32_t submitted = phase.fetch_add( 1 ) + 1;
+			phase.notify_one();
+			phase.wait( submitted );
+		} );
+
+		stop.store( true );
+		phase.fetch_add( 1 );
+		phase.notify_one();
+		worker.join();
+
+		return perFrame / static_cast< double >( count );
+	}
+
+	void PrintRow( std::string_view pattern, std::size_t size, double mallocNs, double slabNs )
+	{
+		Bench::Print( "{:<28} {:>6} {:>10.1f} {:>10.1f} {:>8.2f}x", pattern, size, mallocNs, slabNs, mallocNs / slabNs );
+	}
+} // namespace
+
+SLC_BENCHMARK( SlabAllocation, "SlabAllocator against malloc on Ref objects, event overflow and job captures" )
+{
+	const size_t count = args.GetOr( "count", 4096 );
+
+	Bench::Print( "{} blocks per frame. ns per allocate and free pair.", count );
+	Bench::Print( "{:<28} {:>6} {:>10} {:>10} {:>9}", "pattern", "bytes", "malloc", "slab", "speedup" );
+
+	SlabAllocator slab;
+	double refMalloc = RefObjects( count, [] { return Ref< SharedComponent >::Create(); } );
+	double refSlab = RefObjects( count, [ &slab ] { return Ref< SharedComponent >::CreateIn( slab ); } );
+
+	PrintRow( "Ref::Create, shuffled free", sizeof( SharedComponent ), refMalloc, refSlab );
+	PrintRow( "Event overflow, frame free", sizeof( EventModel< MouseMovedEvent > ), EventOverflowFrame< MallocHeap >( count ), EventOverflowFrame< SlabHeap >( count ) );
+	PrintRow( "Job capture, cross thread", sizeof( JobCapture ), CrossThreadCaptures< MallocHeap, JobCapture >( count ),
+			  CrossThreadCaptures< SlabHeap, JobCapture >( count ) );
+	PrintRow( "Callback capture, cross thread", sizeof( CallbackCapture ), CrossThreadCaptures< MallocHeap, CallbackCapture >( count ),
+			  CrossThreadCaptures< SlabHeap, CallbackCapture >( count ) );
+}
@@ -0,0 +1,35 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+
+// Headless benchmarks for the core systems. Run with no arguments to run everything, or pass part of a
+// benchmark name to select it. --list prints the available benchmarks; other --options are benchmark specific.
+int main( int argc, char** argv )
+{
+	using namespace slc;
+
+	Bench::Arguments args( argc, argv );
+
+	auto& registry = Bench::GetRegistry();
+	std::ranges::sort( registry, {}, &Bench::Benchmark::name );
+
+	if ( args.Has( "list" ) )
+	{
+		for ( const auto& benchmark : registry )
+			Bench::Print( "{:<28} {}", benchmark.name, benchmark.description );
+
+		return 0;
+	}
+
+	for ( const auto& benchmark : registry )
+	{
+		if ( !args.Selects( benchmark.name ) )
+			continue;
+
+		Bench::Print( "== {} - {}", benchmark.name, benchmark.description );
+		benchmark.run( args );
+		Bench::Print( "" );
+	}
+
+	return 0;
+}
@@ -4,9 +4,56 @@
 
 namespace slc {
 
+	/// <summary>
+	/// Static allocator interface. Concrete allocators satisfy this directly so calls through the concrete type
+	/// are plain (inlinable) member calls. Wrap one in AllocatorAdapter when a type erased IAllocator is needed.
+	/// </summary>
+	template < typename T >
+	concept IsAllocator = requires( T& allocator, std::size_t size, void* ptr ) {
+		{ allocator.Allocate( size ) } -> std::same_as< void* >;
+		allocator.Deallocate( ptr );
+		allocator.Reset();
+		{ allocator.MaxSize() } -> std::convertible_to< std::size_t >;
+	};
+
+	/// <summary>
+	/// CRTP base providing typed construction and destruction on top of the derived allocator's Allocate/Deallocate.
+	/// </summary>
+	template < typename TDerived >
+	class AllocatorBase
+	{
+	public:
+		SCONSTEXPR std::size_t SCALE_FACTOR = 2;
+
+		template < typename T, typename... Args >
+		T* Alloc( Args&&... args )
+		{
+			T* ptr = static_cast< T* >( Self().Allocate( sizeof( T ) ) );
+			if ( not ptr )
+				return nullptr;
+
+			new ( ptr ) T( std::forward< Args >( args )... );
+			return ptr;
+		}
+
+		template < typename T >
+		void Free( T* ptr )
+		{
+			ptr->~T();
+			Self().Deallocate( static_cast< void* >( ptr ) );
+		}
+
+	private:
+		TDerived& Self()
+		{
+			return static_cast< TDerived& >( *this );
+		}
+	};
+
 	/// <summary>
 	/// Base allocator interface.
 	/// Inherited classes must provide overrides to retrieve and free fixed size blocks of memory, as well as a max size override.
+	/// Only needed where allocators of different types are stored together; prefer the concrete allocator types otherwise.
 	/// </summary>
 	class IAllocator
 	{
@@ -19,6 +66,9 @@ namespace slc {
 		T* Alloc( Args&&... args )
 		{
 			T* ptr = static_cast< T* >( AllocImpl( sizeof( T ) ) );
+			if ( not ptr )
+				return nullptr;
+
 			new ( ptr ) T( std::forward< Args >( args )... );
 			return ptr;
 		}
@@ -30,6 +80,16 @@ namespace slc {
 			FreeImpl( static_cast< void* >( ptr ) );
 		}
 
+		void* Allocate( std::size_t size )
+		{
+			return AllocImpl( size );
+		}
+
+		void Deallocate( void* ptr )
+		{
+			FreeImpl( ptr );
+		}
+
 		virtual void Reset()
 		{}
 
@@ -37,8 +97,110 @@ namespace slc {
 		{}
 		virtual std::size_t MaxSize() const = 0;
 
+		/// <summary>
+		/// Size every allocation must be, for allocators of a single object type, or 0 if any size is accepted.
+		/// </summary>
+		virtual std::size_t FixedAllocationSize() const
+		{
+			return 0;
+		}
+
+		/// <summary>
+		/// Whether Deallocate releases every live allocation at once rather than only the one passed.
+		/// </summary>
+		virtual bool DeallocateReleasesAll() const
+		{
+			return false;
+		}
+
+		/// <summary>
+		/// Whether only the most recent allocation can be given back, as with a stack.
+		/// </summary>
+		virtual bool DeallocateLastOnly() const
+		{
+			return false;
+		}
+
 	protected:
 		virtual void* AllocImpl( size_t size ) = 0;
 		virtual void FreeImpl( void* ptr = nullptr ) = 0;
 	};
+
+	/// <summary>
+	/// Type erased IAllocator over any static allocator. Code that knows the concrete type can call Get()
+	/// to bypass the virtual dispatch.
+	/// </summary>
+	template < IsAllocator TAllocator >
+	class AllocatorAdapter final : public IAllocator
+	{
+	public:
+		template < typename... Args >
+			requires std::constructible_from< TAllocator, Args... >
+		AllocatorAdapter( Args&&... args )
+			: mAllocator( std::forward< Args >( args )... )
+		{}
+
+		TAllocator& Get()
+		{
+			return mAllocator;
+		}
+		const TAllocator& Get() const
+		{
+			return mAllocator;
+		}
+
+		void Reset() override
+		{
+			mAllocator.Reset();
+		}
+
+		void ForceReallocate() override
+		{
+			if constexpr ( requires { mAllocator.ForceReallocate(); } )
+				mAllocator.ForceReallocate();
+		}
+
+		std::size_t MaxSize() const override
+		{
+			return mAllocator.MaxSize();
+		}
+
+		std::size_t FixedAllocationSize() const override
+		{
+			if constexpr ( requires { TAllocator::FixedAllocationSize; } )
+				return TAllocator::FixedAllocationSize;
+			else
+				return 0;
+		}
+
+		bool DeallocateReleasesAll() const override
+		{
+			if constexpr ( requires { TAllocator::DeallocateReleasesAll; } )
+				return TAllocator::DeallocateReleasesAll;
+			else
+				return false;
+		}
+
+		bool DeallocateLastOnly() const override
+		{
+			if constexpr ( requires { TAllocator::DeallocateLastOnly; } )
+				return TAllocator::DeallocateLastOnly;
+			else
+				return false;
+		}
+
+	protected:
+		void* AllocImpl( size_t size ) override
+		{
+			return mAllocator.Allocate( size );
+		}
+
+		void FreeImpl( void* ptr ) override
+		{
+			mAllocator.Deallocate( ptr );
+		}
+
+	private:
+		TAllocator mAllocator;
+	};
 } // namespace slc
\ No newline at end of file
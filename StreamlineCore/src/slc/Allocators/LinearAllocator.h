@@ -11,15 +11,18 @@ namespace slc {
 	/// </summary>
 	/// <typeparam name="T"></typeparam>
 	template < typename T >
-	class LinearAllocator : public IAllocator
+	class LinearAllocator final : public AllocatorBase< LinearAllocator< T > >
 	{
 	public:
+		SCONSTEXPR std::size_t FixedAllocationSize = sizeof( T );
+		SCONSTEXPR bool DeallocateReleasesAll = true;
+
 		LinearAllocator( size_t size )
 			: mMaxSize( size ), mMemBlock( static_cast< T* >( ::operator new( mMaxSize * sizeof( T ) ) ) ), mHead( mMemBlock )
 		{
 		}
 
-		~LinearAllocator() override
+		~LinearAllocator()
 		{
 			::operator delete( mMemBlock );
 		}
@@ -42,11 +45,11 @@ namespace slc {
 			mHead = other.mHead;
 		}
 
-		std::size_t MaxSize() const override
+		std::size_t MaxSize() const
 		{
 			return mMaxSize;
 		}
-		void ForceReallocate() override
+		void ForceReallocate()
 		{
 			Reallocate();
 		}
@@ -56,8 +59,7 @@ namespace slc {
 			mHead = mMemBlock;
 		}
 
-	protected:
-		void* AllocImpl( size_t size ) override
+		void* Allocate( size_t size )
 		{
 			if ( size != sizeof( T ) )
 				return nullptr;
@@ -68,7 +70,7 @@ namespace slc {
 			return mHead++;
 		}
 
-		void FreeImpl( void* = nullptr ) override
+		void Deallocate( void* = nullptr )
 		{
 			mHead = mMemBlock;
 		}
@@ -80,11 +82,11 @@ namespace slc {
 			ptrdiff_t offset = mHead - mMemBlock;
 			size_t tmpSize = mMaxSize;
 
-			mMaxSize *= SCALE_FACTOR;
+			mMaxSize *= LinearAllocator::SCALE_FACTOR;
 			mMemBlock = static_cast< T* >( ::operator new( mMaxSize * sizeof( T ) ) );
 			mHead = mMemBlock + offset;
 
-			memcpy( mMemBlock, tmp, tmpSize );
+			memcpy( mMemBlock, tmp, tmpSize * sizeof( T ) );
 			::operator delete( tmp );
 		}
 
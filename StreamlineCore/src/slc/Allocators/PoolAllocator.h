@@ -7,7 +7,7 @@
 namespace slc {
 
 	template < typename T >
-	class PoolAllocator : public IAllocator
+	class PoolAllocator final : public AllocatorBase< PoolAllocator< T > >
 	{
 	public:
 		union Block
@@ -18,31 +18,25 @@ namespace slc {
 
 		SASSERT( sizeof( T ) >= sizeof( Block* ), "Free list block size must be smaller than object size." );
 		SCONSTEXPR auto BLOCK_SIZE = sizeof( Block );
+		SCONSTEXPR std::size_t FixedAllocationSize = sizeof( T );
 
 		PoolAllocator( size_t count )
 			: mMaxSize( count )
 		{
 			void* memory = ::operator new( mMaxSize * BLOCK_SIZE );
 			mMemBlock = static_cast< Block* >( memory );
-			mHead = static_cast< Block* >( memory );
 
-			for ( auto i = 1; i < mMaxSize; i++ )
-			{
-				Block* prev_block = &mMemBlock[ i - 1 ];
-				Block* curr_block = &mMemBlock[ i ];
-
-				prev_block->next = curr_block;
-			}
+			Reset();
 		}
 
-		~PoolAllocator() override
+		~PoolAllocator()
 		{
 			::operator delete( mMemBlock );
 		}
 
 		PoolAllocator( const PoolAllocator& ) = delete;
 		PoolAllocator( PoolAllocator&& other ) noexcept
-			: mMaxSize( other.mMaxSize ), mMemBlock( std::exchange( other.mMemBlock, nullptr ) ), mHead( mMemBlock )
+			: mMaxSize( other.mMaxSize ), mMemBlock( std::exchange( other.mMemBlock, nullptr ) ), mHead( std::exchange( other.mHead, nullptr ) )
 		{}
 
 		auto operator=( const PoolAllocator& ) = delete;
@@ -58,19 +52,28 @@ namespace slc {
 			mHead = other.mHead;
 		}
 
-		std::size_t MaxSize() const override
+		std::size_t MaxSize() const
 		{
 			return mMaxSize;
 		}
-		void ForceReallocate() override
+		void ForceReallocate()
 		{
 			Reallocate();
 		}
 
-	protected:
-		void* AllocImpl( size_t size ) override
+		void Reset()
+		{
+			mHead = mMaxSize > 0 ? mMemBlock : nullptr;
+			LinkBlocks( 0 );
+		}
+
+		/// <summary>
+		/// Returns nullptr once every block is in use. The pool never grows by itself, as moving the blocks would
+		/// leave every live object dangling; call ForceReallocate when nothing is allocated to make it bigger.
+		/// </summary>
+		void* Allocate( size_t size )
 		{
-			if ( sizeof( T ) != size )
+			if ( sizeof( T ) != size or not mHead )
 				return nullptr;
 
 			Block* new_value = mHead;
@@ -78,7 +81,7 @@ namespace slc {
 			return &new_value->value;
 		}
 
-		void FreeImpl( void* ptr ) override
+		void Deallocate( void* ptr )
 		{
 			Block* block = static_cast< Block* >( ptr );
 			block->next = mHead;
@@ -89,28 +92,41 @@ namespace slc {
 		void Reallocate()
 		{
 			Block* tmp = mMemBlock;
-
-			ASSERT( mHead > mMemBlock );
-			size_t offset = mHead - mMemBlock;
 			size_t tmpSize = mMaxSize;
 
-			mMaxSize *= SCALE_FACTOR;
+			mMaxSize = std::max< size_t >( mMaxSize * PoolAllocator::SCALE_FACTOR, 1 );
 
 			void* memory = ::operator new( mMaxSize * BLOCK_SIZE );
 			mMemBlock = static_cast< Block* >( memory );
-			mHead = mMemBlock + offset;
+			std::memcpy( mMemBlock, tmp, tmpSize * BLOCK_SIZE );
+
+			// The copied free list still links blocks in the old memory. Translate it to the new blocks, then put
+			// the new blocks on the front.
+			Block** link = &mHead;
+			for ( Block* old = mHead; old; old = old->next )
+			{
+				*link = mMemBlock + ( old - tmp );
+				link = &( *link )->next;
+			}
+			*link = nullptr;
 
-			std::memcpy( mMemBlock, tmp, tmpSize );
 			::operator delete( tmp );
 
+			LinkBlocks( tmpSize );
+			mMemBlock[ mMaxSize - 1 ].next = mHead;
+			mHead = mMemBlock + tmpSize;
+		}
 
-			for ( auto i = offset + 1; i < mMaxSize; i++ )
-			{
-				Block* prev_block = &mMemBlock[ i - 1 ];
-				Block* curr_block = &mMemBlock[ i ];
+		// Chain blocks [first, mMaxSize) into a free list ending in nullptr.
+		void LinkBlocks( size_t first )
+		{
+			if ( first >= mMaxSize )
+				return;
 
-				prev_block->next = curr_block;
-			}
+			for ( size_t i = first + 1; i < mMaxSize; i++ )
+				mMemBlock[ i - 1 ].next = &mMemBlock[ i ];
+
+			mMemBlock[ mMaxSize - 1 ].next = nullptr;
 		}
 
 	private:
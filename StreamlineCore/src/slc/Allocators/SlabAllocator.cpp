@@ -0,0 +1,350 @@
+#include "SlabAllocator.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#ifdef SLC_PLATFORM_WINDOWS
+#include <malloc.h>
+#endif
+
+namespace slc {
+
+	namespace {
+
+		SASSERT( SlabAllocator::GetSizeClass( 1 ) == 0 );
+		SASSERT( SlabAllocator::GetSizeClass( 128 ) == 7 );
+		SASSERT( SlabAllocator::GetSizeClass( 129 ) == 8 );
+		SASSERT( SlabAllocator::GetSizeClass( 256 ) == 11 );
+		SASSERT( SlabAllocator::GetSizeClass( 257 ) == 12 );
+		SASSERT( SlabAllocator::GetSizeClass( SlabAllocator::MaxSmallSize ) == SlabAllocator::SizeClassCount - 1 );
+
+		// Everything in here must avoid ::operator new, since the global operator new may be routed back through this allocator.
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		struct BlockChain
+		{
+			FreeBlock* head = nullptr;
+			FreeBlock* tail = nullptr;
+			std::size_t count = 0;
+		};
+
+		struct CentralList
+		{
+			std::mutex mutex;
+			FreeBlock* head = nullptr;
+			Byte* cursor = nullptr;
+			Byte* end = nullptr;
+		};
+
+		struct ThreadCache
+		{
+			FreeBlock* heads[ SlabAllocator::SizeClassCount ] = {};
+			std::size_t counts[ SlabAllocator::SizeClassCount ] = {};
+			bool registered = false;
+			bool destroyed = false;
+		};
+
+		SCONSTEXPR std::size_t TargetBatchBytes = 8 * 1024;
+
+		// Two level map from slab address to size class + 1, with 0 meaning the address is not in a slab. Covers 48 bit
+		// addresses; slabs placed above that are not used. Leaves are created on demand and never freed.
+		SCONSTEXPR std::size_t SlabShift = std::countr_zero( SlabAllocator::SlabSize );
+		SCONSTEXPR std::size_t AddressBits = 48;
+		SCONSTEXPR std::size_t PageMapLeafBits = 16;
+		SCONSTEXPR std::size_t PageMapRootBits = AddressBits - SlabShift - PageMapLeafBits;
+
+		SASSERT( std::has_single_bit( SlabAllocator::SlabSize ) );
+		SASSERT( SlabAllocator::SizeClassCount < Limits< std::uint8_t >::Max );
+
+		constinit std::array< CentralList, SlabAllocator::SizeClassCount > sCentralLists{};
+
+		constinit std::array< std::atomic< std::uint8_t* >, std::size_t( 1 ) << PageMapRootBits > sPageMap{};
+
+		constinit std::atomic_size_t sSlabCount = 0;
+		constinit std::atomic_size_t sCentralRefills = 0;
+		constinit std::atomic_size_t sCentralReleases = 0;
+
+		constinit thread_local ThreadCache tCache{};
+
+		constexpr std::size_t BatchCount( std::size_t sizeClass )
+		{
+			return std::clamp< std::size_t >( TargetBatchBytes / SlabAllocator::SizeClasses[ sizeClass ], 4, 64 );
+		}
+
+		bool RegisterSlab( Byte* slab, std::size_t sizeClass )
+		{
+			std::uintptr_t page = reinterpret_cast< std::uintptr_t >( slab ) >> SlabShift;
+			if ( page >> ( PageMapRootBits + PageMapLeafBits ) )
+				return false;
+
+			std::atomic< std::uint8_t* >& root = sPageMap[ page >> PageMapLeafBits ];
+			std::uint8_t* leaf = root.load( std::memory_order_acquire );
+			if ( !leaf )
+			{
+				auto* created = static_cast< std::uint8_t* >( std::calloc( std::size_t( 1 ) << PageMapLeafBits, 1 ) );
+				if ( !created )
+					return false;
+
+				if ( root.compare_exchange_strong( leaf, created, std::memory_order_acq_rel, std::memory_order_acquire ) )
+					leaf = created;
+				else
+					std::free( created );
+			}
+
+			// Blocks from the slab are only handed out after this, so anything freeing one sees the entry.
+			leaf[ page & ( ( std::size_t( 1 ) << PageMapLeafBits ) - 1 ) ] = static_cast< std::uint8_t >( sizeClass + 1 );
+			return true;
+		}
+
+		std::size_t LookupSizeClass( const void* ptr )
+		{
+			std::uintptr_t page = reinterpret_cast< std::uintptr_t >( ptr ) >> SlabShift;
+			if ( page >> ( PageMapRootBits + PageMapLeafBits ) )
+				return SlabAllocator::SizeClassCount;
+
+			const std::uint8_t* leaf = sPageMap[ page >> PageMapLeafBits ].load( std::memory_order_acquire );
+			if ( !leaf )
+				return SlabAllocator::SizeClassCount;
+
+			std::uint8_t entry = leaf[ page & ( ( std::size_t( 1 ) << PageMapLeafBits ) - 1 ) ];
+			return entry == 0 ? SlabAllocator::SizeClassCount : entry - 1;
+		}
+
+		Byte* AllocateSlab( std::size_t sizeClass )
+		{
+#ifdef SLC_PLATFORM_WINDOWS
+			auto* slab = static_cast< Byte* >( ::_aligned_malloc( SlabAllocator::SlabSize, SlabAllocator::SlabSize ) );
+#else
+			auto* slab = static_cast< Byte* >( std::aligned_alloc( SlabAllocator::SlabSize, SlabAllocator::SlabSize ) );
+#endif
+			if ( slab && !RegisterSlab( slab, sizeClass ) )
+			{
+#ifdef SLC_PLATFORM_WINDOWS
+				::_aligned_free( slab );
+#else
+				std::free( slab );
+#endif
+				return nullptr;
+			}
+
+			return slab;
+		}
+
+		BlockChain RefillFromCentral( std::size_t sizeClass )
+		{
+			const std::size_t blockSize = SlabAllocator::SizeClasses[ sizeClass ];
+			const std::size_t wanted = BatchCount( sizeClass );
+
+			CentralList& central = sCentralLists[ sizeClass ];
+			std::scoped_lock< std::mutex > lock( central.mutex );
+
+			BlockChain chain;
+			while ( chain.count < wanted )
+			{
+				FreeBlock* block = nullptr;
+				if ( central.head )
+				{
+					block = central.head;
+					central.head = block->next;
+				}
+				else
+				{
+					if ( central.cursor + blockSize > central.end )
+					{
+						Byte* slab = AllocateSlab( sizeClass );
+						if ( !slab )
+							break;
+
+						central.cursor = slab;
+						central.end = slab + SlabAllocator::SlabSize;
+						sSlabCount.fetch_add( 1, std::memory_order_relaxed );
+					}
+
+					block = reinterpret_cast< FreeBlock* >( central.cursor );
+					central.cursor += blockSize;
+				}
+
+				block->next = chain.head;
+				if ( !chain.head )
+					chain.tail = block;
+				chain.head = block;
+				chain.count++;
+			}
+
+			sCentralRefills.fetch_add( 1, std::memory_order_relaxed );
+			return chain;
+		}
+
+		void ReleaseToCentral( std::size_t sizeClass, BlockChain chain )
+		{
+			if ( chain.count == 0 )
+				return;
+
+			CentralList& central = sCentralLists[ sizeClass ];
+			std::scoped_lock< std::mutex > lock( central.mutex );
+
+			chain.tail->next = central.head;
+			central.head = chain.head;
+
+			sCentralReleases.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		BlockChain TakeFromCache( ThreadCache& cache, std::size_t sizeClass, std::size_t count )
+		{
+			BlockChain chain;
+			while ( chain.count < count && cache.heads[ sizeClass ] )
+			{
+				FreeBlock* block = cache.heads[ sizeClass ];
+				cache.heads[ sizeClass ] = block->next;
+
+				block->next = chain.head;
+				if ( !chain.head )
+					chain.tail = block;
+				chain.head = block;
+				chain.count++;
+			}
+
+			cache.counts[ sizeClass ] -= chain.count;
+			return chain;
+		}
+
+		void FlushCache( ThreadCache& cache )
+		{
+			for ( std::size_t i = 0; i < SlabAllocator::SizeClassCount; i++ )
+				ReleaseToCentral( i, TakeFromCache( cache, i, cache.counts[ i ] ) );
+		}
+
+		struct ThreadCacheGuard
+		{
+			~ThreadCacheGuard()
+			{
+				FlushCache( tCache );
+				tCache.destroyed = true;
+			}
+		};
+
+		thread_local ThreadCacheGuard tCacheGuard;
+
+		ThreadCache* GetThreadCache()
+		{
+			ThreadCache& cache = tCache;
+			if ( cache.registered ) [[likely]]
+				return &cache;
+
+			// Frees issued by other thread_local destructors after the cache has been flushed go straight to the central lists.
+			if ( cache.destroyed )
+				return nullptr;
+
+			// Odr-using the guard registers its destructor, which hands the cached blocks back when the thread exits.
+			static_cast< void >( &tCacheGuard );
+			cache.registered = true;
+			return &cache;
+		}
+	} // namespace
+
+	void* SlabAllocator::Allocate( std::size_t size )
+	{
+		std::size_t sizeClass = GetSizeClass( size );
+		if ( sizeClass == SizeClassCount )
+			return std::malloc( size );
+
+		ThreadCache* cache = GetThreadCache();
+		if ( !cache )
+		{
+			BlockChain chain = RefillFromCentral( sizeClass );
+			if ( chain.count == 0 )
+				return nullptr;
+
+			FreeBlock* block = chain.head;
+			chain.head = block->next;
+			chain.count--;
+			ReleaseToCentral( sizeClass, chain );
+			return block;
+		}
+
+		FreeBlock* block = cache->heads[ sizeClass ];
+		if ( !block ) [[unlikely]]
+		{
+			BlockChain chain = RefillFromCentral( sizeClass );
+			if ( chain.count == 0 )
+				return nullptr;
+
+			block = chain.head;
+			cache->heads[ sizeClass ] = chain.head;
+			cache->counts[ sizeClass ] = chain.count;
+		}
+
+		cache->heads[ sizeClass ] = block->next;
+		cache->counts[ sizeClass ]--;
+		return block;
+	}
+
+	void SlabAllocator::Deallocate( void* ptr, std::size_t size )
+	{
+		if ( !ptr )
+			return;
+
+		std::size_t sizeClass = GetSizeClass( size );
+		if ( sizeClass == SizeClassCount )
+		{
+			std::free( ptr );
+			return;
+		}
+
+		FreeBlock* block = static_cast< FreeBlock* >( ptr );
+
+		ThreadCache* cache = GetThreadCache();
+		if ( !cache )
+		{
+			block->next = nullptr;
+			ReleaseToCentral( sizeClass, BlockChain{ block, block, 1 } );
+			return;
+		}
+
+		block->next = cache->heads[ sizeClass ];
+		cache->heads[ sizeClass ] = block;
+		cache->counts[ sizeClass ]++;
+
+		// Keep a thread that only frees (e.g. a consumer of another thread's objects) from hoarding blocks.
+		if ( cache->counts[ sizeClass ] > 2 * BatchCount( sizeClass ) ) [[unlikely]]
+			ReleaseToCentral( sizeClass, TakeFromCache( *cache, sizeClass, BatchCount( sizeClass ) ) );
+	}
+
+	void SlabAllocator::Deallocate( void* ptr )
+	{
+		if ( !ptr )
+			return;
+
+		std::size_t sizeClass = LookupSizeClass( ptr );
+		if ( sizeClass == SizeClassCount )
+		{
+			std::free( ptr );
+			return;
+		}
+
+		Deallocate( ptr, SizeClasses[ sizeClass ] );
+	}
+
+	void SlabAllocator::FlushThreadCache()
+	{
+		if ( ThreadCache* cache = GetThreadCache() )
+			FlushCache( *cache );
+	}
+
+	SlabAllocatorStats SlabAllocator::GetStats()
+	{
+		SlabAllocatorStats stats;
+		stats.slab_count = sSlabCount.load( std::memory_order_relaxed );
+		stats.reserved_bytes = stats.slab_count * SlabSize;
+		stats.central_refills = sCentralRefills.load( std::memory_order_relaxed );
+		stats.central_releases = sCentralReleases.load( std::memory_order_relaxed );
+		return stats;
+	}
+} // namespace slc
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "slc/Common/Base.h"
+
+namespace slc {
+
+	struct SlabAllocatorStats
+	{
+		std::size_t reserved_bytes{};
+		std::size_t slab_count{};
+		std::size_t central_refills{};
+		std::size_t central_releases{};
+	};
+
+	/// <summary>
+	/// General purpose allocator for small objects. Requests up to MaxSmallSize bytes are rounded up to one of a fixed
+	/// set of size classes and served from 64KB slabs carved into equally sized blocks. Each thread keeps a cache of
+	/// free blocks per size class, so the common path is a thread local free list pop/push with no locking. Caches are
+	/// refilled from and returned to a central free list in batches, and flushed back when their thread exits.
+	///
+	/// Larger requests fall through to std::malloc. Slab memory is retained for the lifetime of the process.
+	///
+	/// Slabs are aligned to SlabSize and recorded in a page map, so a block can also be freed without its size by
+	/// looking up the slab it came from. Blocks carry no header either way.
+	/// </summary>
+	class SlabAllocator
+	{
+	public:
+		SCONSTEXPR std::size_t SizeClasses[] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+		SCONSTEXPR std::size_t SizeClassCount = std::size( SizeClasses );
+		SCONSTEXPR std::size_t MaxSmallSize = SizeClasses[ SizeClassCount - 1 ];
+		SCONSTEXPR std::size_t SlabSize = 64 * 1024;
+
+		/// <summary>
+		/// Allocate size bytes, aligned for any fundamental type. Returns nullptr if no memory is left.
+		/// </summary>
+		static void* Allocate( std::size_t size );
+
+		/// <summary>
+		/// Free a block with the size it was allocated with. Cheaper than the unsized overload.
+		/// </summary>
+		static void Deallocate( void* ptr, std::size_t size );
+
+		/// <summary>
+		/// Free a block without knowing its size. The size class is found from the slab the block lies in, and anything
+		/// not in a slab was a large allocation. Used by the global operator delete (see SlabOperatorNew.h).
+		/// </summary>
+		static void Deallocate( void* ptr );
+
+		/// <summary>
+		/// Return every block cached by the calling thread to the central free lists.
+		/// </summary>
+		static void FlushThreadCache();
+
+		static SlabAllocatorStats GetStats();
+
+		static constexpr std::size_t GetSizeClass( std::size_t size )
+		{
+			// Classes are 16 byte steps up to 128, then 32 byte steps up to 256 and 64 byte steps up to 512.
+			if ( size <= 128 )
+				return size == 0 ? 0 : ( size - 1 ) / 16;
+			if ( size <= 256 )
+				return 8 + ( size - 129 ) / 32;
+			if ( size <= MaxSmallSize )
+				return 12 + ( size - 257 ) / 64;
+			return SizeClassCount;
+		}
+	};
+} // namespace slc
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SlabAllocator.h"
+
+#include <new>
+
+// Routes the global operator new/delete through SlabAllocator.
+// Opt in by including this header in exactly one translation unit of the final executable (e.g. next to EntryPoint.h).
+// Over-aligned allocations keep using the default aligned operator new/delete.
+// Sized delete passes its size straight through; unsized delete looks the size class up from the block's slab.
+
+void* operator new( std::size_t size )
+{
+	if ( void* ptr = slc::SlabAllocator::Allocate( size ) )
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[]( std::size_t size )
+{
+	return ::operator new( size );
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	return slc::SlabAllocator::Allocate( size );
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	return slc::SlabAllocator::Allocate( size );
+}
+
+void operator delete( void* ptr ) noexcept
+{
+	slc::SlabAllocator::Deallocate( ptr );
+}
+
+void operator delete[]( void* ptr ) noexcept
+{
+	slc::SlabAllocator::Deallocate( ptr );
+}
+
+void operator delete( void* ptr, std::size_t size ) noexcept
+{
+	slc::SlabAllocator::Deallocate( ptr, size );
+}
+
+void operator delete[]( void* ptr, std::size_t size ) noexcept
+{
+	slc::SlabAllocator::Deallocate( ptr, size );
+}
+
+void operator delete( void* ptr, const std::nothrow_t& ) noexcept
+{
+	slc::SlabAllocator::Deallocate( ptr );
+}
+
+void operator delete[]( void* ptr, const std::nothrow_t& ) noexcept
+{
+	slc::SlabAllocator::Deallocate( ptr );
+}
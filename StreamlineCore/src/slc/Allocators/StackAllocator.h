@@ -4,9 +4,11 @@
 
 namespace slc {
 
-	class StackAllocator : public IAllocator
+	class StackAllocator final : public AllocatorBase< StackAllocator >
 	{
 	public:
+		SCONSTEXPR bool DeallocateLastOnly = true;
+
 		struct AllocHeader
 		{
 			std::size_t size;
@@ -16,7 +18,7 @@ namespace slc {
 			: mMaxSize( size ), mMemBlock( static_cast< Byte* >( ::operator new( mMaxSize ) ) ), mHead( mMemBlock )
 		{}
 
-		~StackAllocator() override
+		~StackAllocator()
 		{
 			::operator delete( mMemBlock );
 		}
@@ -39,17 +41,21 @@ namespace slc {
 			mHead = other.mHead;
 		}
 
-		std::size_t MaxSize() const override
+		std::size_t MaxSize() const
 		{
 			return mMaxSize;
 		}
-		void ForceReallocate() override
+		void ForceReallocate()
 		{
 			Reallocate();
 		}
 
-	protected:
-		void* AllocImpl( size_t size ) override
+		void Reset()
+		{
+			mHead = mMemBlock;
+		}
+
+		void* Allocate( size_t size )
 		{
 			constexpr size_t HeaderSize = sizeof( AllocHeader );
 
@@ -65,7 +71,7 @@ namespace slc {
 			return memblock;
 		}
 
-		void FreeImpl( void* ptr ) override
+		void Deallocate( void* ptr )
 		{
 			constexpr size_t HeaderSize = sizeof( AllocHeader );
 			Byte* bytes = reinterpret_cast< Byte* >( ptr );
@@ -0,0 +1,266 @@
+#include "TlsfAllocator.h"
+
+#include <bit>
+
+namespace slc {
+
+	TlsfAllocator::TlsfAllocator( std::size_t size, std::size_t granularity, std::size_t maxAllocations )
+		: mSize( size )
+		, mGranularity( granularity )
+		, mGranularityLog2( static_cast< uint32_t >( std::countr_zero( granularity ) ) )
+	{
+		ASSERT( std::has_single_bit( granularity ), "TLSF granularity must be a power of two" );
+
+		// Every allocation can split at most one free range, so twice the allocation count bounds the node count.
+		mNodes.reserve( maxAllocations * 2 + 1 );
+		mFreeNodes.reserve( maxAllocations * 2 + 1 );
+
+		Reset();
+	}
+
+	TlsfAllocator::Allocation TlsfAllocator::Allocate( std::size_t size )
+	{
+		std::size_t units = std::max< std::size_t >( ( size + mGranularity - 1 ) >> mGranularityLog2, 1 );
+		if ( units > mFreeUnits )
+			return {};
+
+		BinIndex bin = MappingSearch( units );
+		if ( !FindFreeBin( bin ) )
+			return {};
+
+		NodeIndex index = mBins[ bin.first ][ bin.second ];
+		RemoveFreeNode( index );
+
+		Node& node = mNodes[ index ];
+		node.used = true;
+		mUsedRangeCount++;
+		mFreeUnits -= node.size;
+
+		// Return the unused tail of the range to the free bins.
+		if ( std::size_t remainder = node.size - units; remainder > 0 )
+		{
+			NodeIndex tailIndex = NewNode();
+
+			Node& owner = mNodes[ index ];
+			Node& tail = mNodes[ tailIndex ];
+			tail.offset = owner.offset + units;
+			tail.size = remainder;
+			tail.neighbourPrev = index;
+			tail.neighbourNext = owner.neighbourNext;
+
+			if ( owner.neighbourNext != InvalidNode )
+				mNodes[ owner.neighbourNext ].neighbourPrev = tailIndex;
+
+			owner.neighbourNext = tailIndex;
+			owner.size = units;
+
+			mFreeUnits += remainder;
+			InsertFreeNode( tailIndex );
+		}
+
+		return { mNodes[ index ].offset << mGranularityLog2, index };
+	}
+
+	void TlsfAllocator::Free( Allocation allocation )
+	{
+		if ( !allocation.Valid() )
+			return;
+
+		NodeIndex index = allocation.node;
+		ASSERT( mNodes[ index ].used, "Double free of TLSF allocation" );
+
+		mNodes[ index ].used = false;
+		mUsedRangeCount--;
+		mFreeUnits += mNodes[ index ].size;
+
+		// Coalesce with the previous range, keeping the earlier node.
+		if ( NodeIndex prevIndex = mNodes[ index ].neighbourPrev; prevIndex != InvalidNode && !mNodes[ prevIndex ].used )
+		{
+			RemoveFreeNode( prevIndex );
+
+			Node& prev = mNodes[ prevIndex ];
+			Node& node = mNodes[ index ];
+			prev.size += node.size;
+			prev.neighbourNext = node.neighbourNext;
+			if ( node.neighbourNext != InvalidNode )
+				mNodes[ node.neighbourNext ].neighbourPrev = prevIndex;
+
+			ReleaseNode( index );
+			index = prevIndex;
+		}
+
+		// Coalesce with the next range.
+		if ( NodeIndex nextIndex = mNodes[ index ].neighbourNext; nextIndex != InvalidNode && !mNodes[ nextIndex ].used )
+		{
+			RemoveFreeNode( nextIndex );
+
+			Node& node = mNodes[ index ];
+			Node& next = mNodes[ nextIndex ];
+			node.size += next.size;
+			node.neighbourNext = next.neighbourNext;
+			if ( next.neighbourNext != InvalidNode )
+				mNodes[ next.neighbourNext ].neighbourPrev = index;
+
+			ReleaseNode( nextIndex );
+		}
+
+		InsertFreeNode( index );
+	}
+
+	void TlsfAllocator::Reset()
+	{
+		mFirstLevelBitmap = 0;
+		mSecondLevelBitmaps.fill( 0 );
+		for ( auto& bins : mBins )
+			bins.fill( InvalidNode );
+
+		mNodes.clear();
+		mFreeNodes.clear();
+		mFreeUnits = 0;
+		mFreeRangeCount = 0;
+		mUsedRangeCount = 0;
+
+		std::size_t units = mSize >> mGranularityLog2;
+		if ( units == 0 )
+			return;
+
+		NodeIndex index = NewNode();
+		mNodes[ index ].offset = 0;
+		mNodes[ index ].size = units;
+		mFreeUnits = units;
+		InsertFreeNode( index );
+	}
+
+	std::size_t TlsfAllocator::AllocationSize( Allocation allocation ) const
+	{
+		if ( !allocation.Valid() )
+			return 0;
+
+		return mNodes[ allocation.node ].size << mGranularityLog2;
+	}
+
+	TlsfAllocator::StorageReport TlsfAllocator::GetStorageReport() const
+	{
+		StorageReport report;
+		report.total_free = mFreeUnits << mGranularityLog2;
+		report.free_ranges = mFreeRangeCount;
+		report.used_ranges = mUsedRangeCount;
+
+		if ( mFirstLevelBitmap == 0 )
+			return report;
+
+		// The largest range lives in the highest non-empty bin, but ranges within one bin differ in size so scan it.
+		uint32_t first = 63 - std::countl_zero( mFirstLevelBitmap );
+		uint32_t second = 31 - std::countl_zero( mSecondLevelBitmaps[ first ] );
+
+		std::size_t largest = 0;
+		for ( NodeIndex index = mBins[ first ][ second ]; index != InvalidNode; index = mNodes[ index ].binNext )
+			largest = std::max( largest, mNodes[ index ].size );
+
+		report.largest_free = largest << mGranularityLog2;
+		return report;
+	}
+
+	TlsfAllocator::BinIndex TlsfAllocator::MappingInsert( std::size_t units )
+	{
+		if ( units < SecondLevelCount )
+			return { 0, static_cast< uint32_t >( units ) };
+
+		uint32_t msb = static_cast< uint32_t >( std::bit_width( units ) ) - 1;
+		uint32_t first = msb - SecondLevelLog2 + 1;
+		uint32_t second = static_cast< uint32_t >( units >> ( msb - SecondLevelLog2 ) ) - SecondLevelCount;
+		return { first, second };
+	}
+
+	TlsfAllocator::BinIndex TlsfAllocator::MappingSearch( std::size_t units )
+	{
+		// Round up to the next bin boundary so any range in the resulting bin is large enough.
+		if ( units >= SecondLevelCount )
+		{
+			uint32_t msb = static_cast< uint32_t >( std::bit_width( units ) ) - 1;
+			std::size_t round = ( std::size_t( 1 ) << ( msb - SecondLevelLog2 ) ) - 1;
+			units = units > Limits< std::size_t >::Max - round ? Limits< std::size_t >::Max : units + round;
+		}
+
+		return MappingInsert( units );
+	}
+
+	bool TlsfAllocator::FindFreeBin( BinIndex& bin ) const
+	{
+		uint32_t secondMap = mSecondLevelBitmaps[ bin.first ] & ( ~0u << bin.second );
+		if ( secondMap == 0 )
+		{
+			uint64_t firstMap = bin.first + 1 < 64 ? mFirstLevelBitmap & ( ~uint64_t( 0 ) << ( bin.first + 1 ) ) : 0;
+			if ( firstMap == 0 )
+				return false;
+
+			bin.first = static_cast< uint32_t >( std::countr_zero( firstMap ) );
+			secondMap = mSecondLevelBitmaps[ bin.first ];
+		}
+
+		bin.second = static_cast< uint32_t >( std::countr_zero( secondMap ) );
+		return true;
+	}
+
+	void TlsfAllocator::InsertFreeNode( NodeIndex index )
+	{
+		Node& node = mNodes[ index ];
+		BinIndex bin = MappingInsert( node.size );
+
+		NodeIndex& head = mBins[ bin.first ][ bin.second ];
+		node.binPrev = InvalidNode;
+		node.binNext = head;
+		if ( head != InvalidNode )
+			mNodes[ head ].binPrev = index;
+		head = index;
+
+		mFirstLevelBitmap |= uint64_t( 1 ) << bin.first;
+		mSecondLevelBitmaps[ bin.first ] |= 1u << bin.second;
+		mFreeRangeCount++;
+	}
+
+	void TlsfAllocator::RemoveFreeNode( NodeIndex index )
+	{
+		Node& node = mNodes[ index ];
+		BinIndex bin = MappingInsert( node.size );
+
+		if ( node.binPrev != InvalidNode )
+			mNodes[ node.binPrev ].binNext = node.binNext;
+		else
+			mBins[ bin.first ][ bin.second ] = node.binNext;
+
+		if ( node.binNext != InvalidNode )
+			mNodes[ node.binNext ].binPrev = node.binPrev;
+
+		node.binPrev = InvalidNode;
+		node.binNext = InvalidNode;
+
+		if ( mBins[ bin.first ][ bin.second ] == InvalidNode )
+		{
+			mSecondLevelBitmaps[ bin.first ] &= ~( 1u << bin.second );
+			if ( mSecondLevelBitmaps[ bin.first ] == 0 )
+				mFirstLevelBitmap &= ~( uint64_t( 1 ) << bin.first );
+		}
+
+		mFreeRangeCount--;
+	}
+
+	TlsfAllocator::NodeIndex TlsfAllocator::NewNode()
+	{
+		if ( !mFreeNodes.empty() )
+		{
+			NodeIndex index = mFreeNodes.back();
+			mFreeNodes.pop_back();
+			mNodes[ index ] = Node{};
+			return index;
+		}
+
+		mNodes.emplace_back();
+		return static_cast< NodeIndex >( mNodes.size() - 1 );
+	}
+
+	void TlsfAllocator::ReleaseNode( NodeIndex index )
+	{
+		mFreeNodes.push_back( index );
+	}
+} // namespace slc
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "slc/Common/Base.h"
+
+namespace slc {
+
+	/// <summary>
+	/// Two-level segregated fit allocator over an abstract range of offsets [0, size).
+	/// All metadata is stored outside the managed range, so it can suballocate a host memory block
+	/// (base pointer + offset) just as well as a GPU buffer that cannot be written to from the CPU.
+	///
+	/// Free ranges are binned by size in a two-level table with a bitmap per level, so finding, splitting
+	/// and coalescing a range are constant time regardless of how many ranges exist. Offsets and sizes are
+	/// rounded up to the granularity passed on construction.
+	/// </summary>
+	class TlsfAllocator
+	{
+	public:
+		using NodeIndex = uint32_t;
+
+		SCONSTEXPR NodeIndex InvalidNode = Limits< NodeIndex >::Max;
+		SCONSTEXPR std::size_t NoSpace = Limits< std::size_t >::Max;
+
+		SCONSTEXPR uint32_t SecondLevelLog2 = 4;
+		SCONSTEXPR uint32_t SecondLevelCount = 1 << SecondLevelLog2;
+		SCONSTEXPR uint32_t FirstLevelCount = 64 - SecondLevelLog2 + 1;
+
+		struct Allocation
+		{
+			std::size_t offset = NoSpace;
+			NodeIndex node = InvalidNode;
+
+			bool Valid() const
+			{
+				return node != InvalidNode;
+			}
+			operator bool() const
+			{
+				return Valid();
+			}
+		};
+
+		struct StorageReport
+		{
+			std::size_t total_free{};
+			std::size_t largest_free{};
+			std::size_t free_ranges{};
+			std::size_t used_ranges{};
+
+			/// <summary>
+			/// 0 when all free space is one contiguous range, approaching 1 as it is split into many small ones.
+			/// </summary>
+			float Fragmentation() const
+			{
+				return total_free == 0 ? 0.0f : 1.0f - static_cast< float >( largest_free ) / static_cast< float >( total_free );
+			}
+		};
+
+	public:
+		/// <param name="size">Size of the managed range in bytes</param>
+		/// <param name="granularity">Alignment and size rounding of every allocation. Must be a power of two.</param>
+		/// <param name="maxAllocations">Expected number of live allocations, used to preallocate metadata.</param>
+		TlsfAllocator( std::size_t size, std::size_t granularity = 16, std::size_t maxAllocations = 4096 );
+
+		Allocation Allocate( std::size_t size );
+		void Free( Allocation allocation );
+
+		/// <summary>
+		/// Release every allocation at once.
+		/// </summary>
+		void Reset();
+
+		std::size_t AllocationSize( Allocation allocation ) const;
+		std::size_t Size() const
+		{
+			return mSize;
+		}
+
+		StorageReport GetStorageReport() const;
+
+	private:
+		struct Node
+		{
+			std::size_t offset = 0;
+			std::size_t size = 0;
+
+			NodeIndex binPrev = InvalidNode;
+			NodeIndex binNext = InvalidNode;
+			NodeIndex neighbourPrev = InvalidNode;
+			NodeIndex neighbourNext = InvalidNode;
+
+			bool used = false;
+		};
+
+		struct BinIndex
+		{
+			uint32_t first;
+			uint32_t second;
+		};
+
+		static BinIndex MappingInsert( std::size_t units );
+		static BinIndex MappingSearch( std::size_t units );
+
+		bool FindFreeBin( BinIndex& bin ) const;
+
+		void InsertFreeNode( NodeIndex index );
+		void RemoveFreeNode( NodeIndex index );
+
+		NodeIndex NewNode();
+		void ReleaseNode( NodeIndex index );
+
+	private:
+		std::size_t mSize;
+		std::size_t mGranularity;
+		uint32_t mGranularityLog2;
+
+		uint64_t mFirstLevelBitmap = 0;
+		std::array< uint32_t, FirstLevelCount > mSecondLevelBitmaps{};
+		std::array< std::array< NodeIndex, SecondLevelCount >, FirstLevelCount > mBins;
+
+		std::vector< Node > mNodes;
+		std::vector< NodeIndex > mFreeNodes;
+
+		std::size_t mFreeUnits = 0;
+		std::size_t mFreeRangeCount = 0;
+		std::size_t mUsedRangeCount = 0;
+	};
+} // namespace slc
@@ -0,0 +1,180 @@
+#include "TrackingAllocator.h"
+
+#include <bit>
+#include <cstring>
+
+namespace slc {
+
+	TrackingAllocator::TrackingAllocator( IAllocator& allocator, std::string label )
+		: mAllocator( &allocator )
+		, mLabel( std::move( label ) )
+		, mFixedSize( allocator.FixedAllocationSize() )
+		, mReleasesAll( allocator.DeallocateReleasesAll() )
+		, mLastMaxSize( allocator.MaxSize() )
+	{
+		std::scoped_lock< std::mutex > lock( sRegistryMutex );
+		sRegistry.push_back( this );
+	}
+
+	TrackingAllocator::TrackingAllocator( Unique< IAllocator > allocator, std::string label )
+		: mAllocator( allocator.get() )
+		, mOwnedAllocator( std::move( allocator ) )
+		, mLabel( std::move( label ) )
+		, mFixedSize( mAllocator->FixedAllocationSize() )
+		, mReleasesAll( mAllocator->DeallocateReleasesAll() )
+		, mLastMaxSize( mAllocator->MaxSize() )
+	{
+		std::scoped_lock< std::mutex > lock( sRegistryMutex );
+		sRegistry.push_back( this );
+	}
+
+	TrackingAllocator::~TrackingAllocator()
+	{
+		std::scoped_lock< std::mutex > lock( sRegistryMutex );
+		std::erase( sRegistry, this );
+	}
+
+	void TrackingAllocator::Reset()
+	{
+		mAllocator->Reset();
+		RecordReleaseAll();
+		mResetCount.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	void TrackingAllocator::ForceReallocate()
+	{
+		mAllocator->ForceReallocate();
+		mLastMaxSize = mAllocator->MaxSize();
+		mReallocationCount.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	AllocatorStats TrackingAllocator::Snapshot() const
+	{
+		AllocatorStats stats;
+		stats.label = mLabel;
+		stats.current_bytes = mCurrentBytes.load( std::memory_order_relaxed );
+		stats.peak_bytes = mPeakBytes.load( std::memory_order_relaxed );
+		stats.total_bytes = mTotalBytes.load( std::memory_order_relaxed );
+		stats.allocation_count = mAllocationCount.load( std::memory_order_relaxed );
+		stats.free_count = mFreeCount.load( std::memory_order_relaxed );
+		stats.live_allocations = mLiveCount.load( std::memory_order_relaxed );
+		stats.failed_allocations = mFailedAllocations.load( std::memory_order_relaxed );
+		stats.reallocation_count = mReallocationCount.load( std::memory_order_relaxed );
+		stats.reset_count = mResetCount.load( std::memory_order_relaxed );
+
+		for ( std::size_t i = 0; i < AllocatorStats::LifetimeBucketCount; i++ )
+			stats.lifetime_histogram[ i ] = mLifetimeHistogram[ i ].load( std::memory_order_relaxed );
+
+		return stats;
+	}
+
+	std::vector< AllocatorStats > TrackingAllocator::SnapshotAll()
+	{
+		std::scoped_lock< std::mutex > lock( sRegistryMutex );
+
+		std::vector< AllocatorStats > result;
+		result.reserve( sRegistry.size() );
+		for ( const TrackingAllocator* allocator : sRegistry )
+			result.push_back( allocator->Snapshot() );
+
+		return result;
+	}
+
+	void* TrackingAllocator::AllocImpl( size_t size )
+	{
+		const bool withHeader = mFixedSize == 0;
+
+		void* block = mAllocator->Allocate( withHeader ? size + HeaderSize : size );
+		if ( !block )
+		{
+			mFailedAllocations.fetch_add( 1, std::memory_order_relaxed );
+			return nullptr;
+		}
+
+		RecordGrowth();
+
+		void* ptr = block;
+		if ( withHeader )
+		{
+			AllocationHeader header{ size, Clock::now() };
+			std::memcpy( block, &header, sizeof( header ) );
+			ptr = static_cast< Byte* >( block ) + HeaderSize;
+		}
+
+		// Only the owning thread writes these, so a load/store pair is enough to keep the peak monotonic.
+		std::size_t current = mCurrentBytes.fetch_add( size, std::memory_order_relaxed ) + size;
+		if ( current > mPeakBytes.load( std::memory_order_relaxed ) )
+			mPeakBytes.store( current, std::memory_order_relaxed );
+
+		mTotalBytes.fetch_add( size, std::memory_order_relaxed );
+		mAllocationCount.fetch_add( 1, std::memory_order_relaxed );
+		mLiveCount.fetch_add( 1, std::memory_order_relaxed );
+		return ptr;
+	}
+
+	void TrackingAllocator::FreeImpl( void* ptr )
+	{
+		if ( mReleasesAll )
+		{
+			mAllocator->Deallocate( ptr );
+			RecordReleaseAll();
+			return;
+		}
+
+		if ( !ptr )
+			return;
+
+		if ( mFixedSize != 0 )
+		{
+			mAllocator->Deallocate( ptr );
+			RecordFree( mFixedSize );
+			return;
+		}
+
+		void* block = static_cast< Byte* >( ptr ) - HeaderSize;
+
+		AllocationHeader header;
+		std::memcpy( &header, block, sizeof( header ) );
+		mAllocator->Deallocate( block );
+
+		RecordFree( header.size );
+		mLifetimeHistogram[ LifetimeBucket( Clock::now() - header.timestamp ) ].fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	void TrackingAllocator::RecordFree( std::size_t size )
+	{
+		mCurrentBytes.fetch_sub( size, std::memory_order_relaxed );
+		mFreeCount.fetch_add( 1, std::memory_order_relaxed );
+		mLiveCount.fetch_sub( 1, std::memory_order_relaxed );
+	}
+
+	void TrackingAllocator::RecordReleaseAll()
+	{
+		// Everything live ends here. Their timestamps are not reachable without a side table, so no lifetimes.
+		mFreeCount.fetch_add( mLiveCount.exchange( 0, std::memory_order_relaxed ), std::memory_order_relaxed );
+		mCurrentBytes.store( 0, std::memory_order_relaxed );
+	}
+
+	void TrackingAllocator::RecordGrowth()
+	{
+		// Allocators that grow on demand do it inside Allocate, so count those as reallocations too.
+		const std::size_t maxSize = mAllocator->MaxSize();
+		if ( maxSize == mLastMaxSize )
+			return;
+
+		if ( maxSize > mLastMaxSize )
+			mReallocationCount.fetch_add( 1, std::memory_order_relaxed );
+
+		mLastMaxSize = maxSize;
+	}
+
+	std::size_t TrackingAllocator::LifetimeBucket( Clock::duration lifetime )
+	{
+		auto micros = std::chrono::duration_cast< std::chrono::microseconds >( lifetime ).count();
+		if ( micros <= 0 )
+			return 0;
+
+		std::size_t bucket = std::bit_width( static_cast< std::size_t >( micros ) );
+		return std::min( bucket, AllocatorStats::LifetimeBucketCount - 1 );
+	}
+} // namespace slc
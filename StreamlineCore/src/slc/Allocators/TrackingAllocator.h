@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Allocator.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace slc {
+
+	/// <summary>
+	/// Point in time copy of the statistics recorded by a TrackingAllocator.
+	/// Lifetime histogram bucket i counts allocations that lived for less than 2^i microseconds,
+	/// with the final bucket collecting everything longer.
+	/// </summary>
+	struct AllocatorStats
+	{
+		SCONSTEXPR std::size_t LifetimeBucketCount = 24;
+
+		std::string label;
+
+		std::size_t current_bytes{};
+		std::size_t peak_bytes{};
+		std::size_t total_bytes{};
+
+		std::size_t allocation_count{};
+		std::size_t free_count{};
+		std::size_t live_allocations{};
+		std::size_t failed_allocations{};
+
+		std::size_t reallocation_count{};
+		std::size_t reset_count{};
+
+		std::array< std::size_t, LifetimeBucketCount > lifetime_histogram{};
+	};
+
+	/// <summary>
+	/// Decorator that forwards to any IAllocator while recording current and peak usage, allocation counts,
+	/// reallocations and allocation lifetimes. Counters are relaxed atomics so Snapshot() can be called
+	/// from another thread (e.g. a debug overlay) while the owning thread keeps allocating.
+	///
+	/// Nothing is stored on the side. Allocators that take any size get a small header in front of each
+	/// allocation holding its size and timestamp, which moves with the data if the allocator grows. Fixed size
+	/// allocators already know the size, so they are tracked with counters alone and have no lifetimes.
+	/// Allocations released in bulk, by Reset or by an allocator whose Deallocate frees everything, are counted
+	/// as freed but not added to the lifetime histogram.
+	///
+	/// Every live TrackingAllocator is registered under its label so all arenas can be dumped at once with SnapshotAll().
+	/// </summary>
+	class TrackingAllocator : public IAllocator
+	{
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct AllocationHeader
+		{
+			std::size_t size;
+			Clock::time_point timestamp;
+		};
+
+		// Keeps the allocation after the header as aligned as the block the wrapped allocator returned.
+		SCONSTEXPR std::size_t HeaderSize = ( sizeof( AllocationHeader ) + alignof( std::max_align_t ) - 1 ) & ~( alignof( std::max_align_t ) - 1 );
+
+	public:
+		TrackingAllocator( IAllocator& allocator, std::string label );
+		TrackingAllocator( Unique< IAllocator > allocator, std::string label );
+		~TrackingAllocator() override;
+
+		TrackingAllocator( const TrackingAllocator& ) = delete;
+		auto operator=( const TrackingAllocator& ) = delete;
+
+		std::size_t MaxSize() const override
+		{
+			return mAllocator->MaxSize();
+		}
+
+		std::size_t FixedAllocationSize() const override
+		{
+			return mFixedSize;
+		}
+
+		bool DeallocateReleasesAll() const override
+		{
+			return mReleasesAll;
+		}
+
+		bool DeallocateLastOnly() const override
+		{
+			return mAllocator->DeallocateLastOnly();
+		}
+
+		void Reset() override;
+		void ForceReallocate() override;
+
+		const std::string& GetLabel() const
+		{
+			return mLabel;
+		}
+
+		IAllocator& GetAllocator()
+		{
+			return *mAllocator;
+		}
+
+		/// <summary>
+		/// Copy the current statistics. Cheap enough to call every frame.
+		/// </summary>
+		AllocatorStats Snapshot() const;
+
+		/// <summary>
+		/// Snapshot every live tracking allocator, in order of construction.
+		/// </summary>
+		static std::vector< AllocatorStats > SnapshotAll();
+
+	protected:
+		void* AllocImpl( size_t size ) override;
+		void FreeImpl( void* ptr = nullptr ) override;
+
+	private:
+		void RecordFree( std::size_t size );
+		void RecordReleaseAll();
+		void RecordGrowth();
+
+		static std::size_t LifetimeBucket( Clock::duration lifetime );
+
+	private:
+		IAllocator* mAllocator;
+		Unique< IAllocator > mOwnedAllocator;
+		std::string mLabel;
+
+		// 0 when allocations carry a header.
+		std::size_t mFixedSize;
+		bool mReleasesAll;
+		// Owning thread only. Used to spot the wrapped allocator growing by itself.
+		std::size_t mLastMaxSize;
+
+		std::atomic_size_t mCurrentBytes = 0;
+		std::atomic_size_t mPeakBytes = 0;
+		std::atomic_size_t mTotalBytes = 0;
+		std::atomic_size_t mAllocationCount = 0;
+		std::atomic_size_t mFreeCount = 0;
+		std::atomic_size_t mLiveCount = 0;
+		std::atomic_size_t mFailedAllocations = 0;
+		std::atomic_size_t mReallocationCount = 0;
+		std::atomic_size_t mResetCount = 0;
+		std::array< std::atomic_size_t, AllocatorStats::LifetimeBucketCount > mLifetimeHistogram{};
+
+		inline static std::mutex sRegistryMutex;
+		inline static std::vector< TrackingAllocator* > sRegistry;
+	};
+} // namespace slc
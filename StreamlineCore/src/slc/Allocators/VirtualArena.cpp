@@ -0,0 +1,239 @@
+#include "VirtualArena.h"
+
+#include "slc/Common/Profiling.h"
+
+#ifdef SLC_PLATFORM_WINDOWS
+#include "Windows.h"
+#elif defined( SLC_PLATFORM_LINUX )
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+	using namespace slc;
+
+	static std::size_t GetPageSizeNative()
+	{
+#ifdef SLC_PLATFORM_WINDOWS
+		SYSTEM_INFO info;
+		GetSystemInfo( &info );
+		return static_cast< std::size_t >( info.dwPageSize );
+#elif defined( SLC_PLATFORM_LINUX )
+		return static_cast< std::size_t >( ::sysconf( _SC_PAGESIZE ) );
+#endif
+	}
+
+	static void* ReserveNative( std::size_t size )
+	{
+#ifdef SLC_PLATFORM_WINDOWS
+		return VirtualAlloc( nullptr, size, MEM_RESERVE, PAGE_NOACCESS );
+#elif defined( SLC_PLATFORM_LINUX )
+		void* ptr = ::mmap( nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+		return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+	}
+
+	static void ReleaseNative( void* ptr, std::size_t size )
+	{
+#ifdef SLC_PLATFORM_WINDOWS
+		VirtualFree( ptr, 0, MEM_RELEASE );
+#elif defined( SLC_PLATFORM_LINUX )
+		::munmap( ptr, size );
+#endif
+	}
+
+	static void PrefaultNative( Byte* ptr, std::size_t size, std::size_t pageSize )
+	{
+		SLC_PROFILE_FUNCTION();
+
+#if defined( SLC_PLATFORM_LINUX ) && defined( MADV_POPULATE_WRITE )
+		if ( ::madvise( ptr, size, MADV_POPULATE_WRITE ) == 0 )
+			return;
+#endif
+		// Fall back to touching every page so the faults are taken now rather than on first use.
+		for ( std::size_t offset = 0; offset < size; offset += pageSize )
+			*reinterpret_cast< volatile char* >( ptr + offset ) = 0;
+	}
+
+	static bool CommitNative( Byte* ptr, std::size_t size, const VirtualArenaOptions& options, std::size_t pageSize, bool& hugePagesActive )
+	{
+		SLC_PROFILE_FUNCTION();
+
+#ifdef SLC_PLATFORM_WINDOWS
+		// Large pages on Windows have to be committed with the reservation, so they cannot be used for on-demand commits.
+		if ( !VirtualAlloc( ptr, size, MEM_COMMIT, PAGE_READWRITE ) )
+			return false;
+
+		if ( options.prefault )
+			PrefaultNative( ptr, size, pageSize );
+
+		return true;
+#elif defined( SLC_PLATFORM_LINUX )
+		constexpr int Protection = PROT_READ | PROT_WRITE;
+		constexpr int Flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+		const int populate = options.prefault ? MAP_POPULATE : 0;
+
+		if ( options.hugePages )
+		{
+			// Explicit huge pages only succeed if the administrator has reserved some (vm.nr_hugepages).
+			if ( ::mmap( ptr, size, Protection, Flags | MAP_HUGETLB | populate, -1, 0 ) != MAP_FAILED )
+			{
+				hugePagesActive = true;
+				return true;
+			}
+
+			// Otherwise ask for transparent huge pages. Advise before faulting so the kernel can back the range with huge pages directly.
+			if ( ::mmap( ptr, size, Protection, Flags, -1, 0 ) == MAP_FAILED )
+				return false;
+
+			hugePagesActive = ::madvise( ptr, size, MADV_HUGEPAGE ) == 0;
+
+			if ( options.prefault )
+				PrefaultNative( ptr, size, pageSize );
+
+			return true;
+		}
+
+		return ::mmap( ptr, size, Protection, Flags | populate, -1, 0 ) != MAP_FAILED;
+#endif
+	}
+
+	static void DecommitNative( Byte* ptr, std::size_t size )
+	{
+#ifdef SLC_PLATFORM_WINDOWS
+		VirtualFree( ptr, size, MEM_DECOMMIT );
+#elif defined( SLC_PLATFORM_LINUX )
+		// Mapping fresh inaccessible pages over the range drops the old ones while keeping the address space reserved.
+		::mmap( ptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1, 0 );
+#endif
+	}
+} // namespace
+
+namespace slc {
+
+	VirtualArena::VirtualArena( std::size_t reserveSize, VirtualArenaOptions options )
+		: mOptions( options )
+	{
+		const std::size_t pageSize = GetPageSizeNative();
+		const std::size_t alignment = mOptions.hugePages ? std::max( HugePageSize, pageSize ) : pageSize;
+
+		mGranularity = ( std::max( mOptions.commitGranularity, alignment ) + alignment - 1 ) / alignment * alignment;
+		mReserved = RoundToGranularity( reserveSize );
+
+		// Over-reserve so the base can be aligned to the huge page size.
+		mMappingSize = mReserved + ( alignment > pageSize ? alignment : 0 );
+		mMapping = ReserveNative( mMappingSize );
+		if ( !mMapping )
+		{
+			// Leave an empty arena that IsValid reports on and every Push fails for, rather than asserting.
+			mMappingSize = 0;
+			mReserved = 0;
+			return;
+		}
+
+		auto address = reinterpret_cast< std::uintptr_t >( mMapping );
+		mBase = reinterpret_cast< Byte* >( ( address + alignment - 1 ) / alignment * alignment );
+
+		if ( mOptions.initialCommit > 0 )
+			Commit( mOptions.initialCommit );
+	}
+
+	VirtualArena::~VirtualArena()
+	{
+		Release();
+	}
+
+	VirtualArena::VirtualArena( VirtualArena&& other ) noexcept
+		: mBase( std::exchange( other.mBase, nullptr ) )
+		, mMapping( std::exchange( other.mMapping, nullptr ) )
+		, mMappingSize( std::exchange( other.mMappingSize, 0 ) )
+		, mReserved( std::exchange( other.mReserved, 0 ) )
+		, mCommitted( std::exchange( other.mCommitted, 0 ) )
+		, mUsed( std::exchange( other.mUsed, 0 ) )
+		, mGranularity( other.mGranularity )
+		, mOptions( other.mOptions )
+		, mHugePagesActive( other.mHugePagesActive )
+	{
+	}
+
+	VirtualArena& VirtualArena::operator=( VirtualArena&& other ) noexcept
+	{
+		if ( this == &other )
+			return *this;
+
+		Release();
+
+		mBase = std::exchange( other.mBase, nullptr );
+		mMapping = std::exchange( other.mMapping, nullptr );
+		mMappingSize = std::exchange( other.mMappingSize, 0 );
+		mReserved = std::exchange( other.mReserved, 0 );
+		mCommitted = std::exchange( other.mCommitted, 0 );
+		mUsed = std::exchange( other.mUsed, 0 );
+		mGranularity = other.mGranularity;
+		mOptions = other.mOptions;
+		mHugePagesActive = other.mHugePagesActive;
+		return *this;
+	}
+
+	void* VirtualArena::Push( std::size_t size, std::size_t alignment )
+	{
+		std::size_t offset = ( mUsed + alignment - 1 ) & ~( alignment - 1 );
+		if ( offset + size > mReserved )
+			return nullptr;
+
+		if ( offset + size > mCommitted ) [[unlikely]]
+		{
+			if ( !Commit( offset + size ) )
+				return nullptr;
+		}
+
+		mUsed = offset + size;
+		return mBase + offset;
+	}
+
+	void VirtualArena::PopTo( std::size_t offset )
+	{
+		ASSERT( offset <= mUsed, "Cannot pop arena forwards" );
+		mUsed = offset;
+	}
+
+	bool VirtualArena::Commit( std::size_t size )
+	{
+		if ( size <= mCommitted )
+			return true;
+
+		if ( size > mReserved )
+			return false;
+
+		std::size_t target = std::min( RoundToGranularity( size ), mReserved );
+		if ( !CommitNative( mBase + mCommitted, target - mCommitted, mOptions, GetPageSizeNative(), mHugePagesActive ) )
+			return false;
+
+		mCommitted = target;
+		return true;
+	}
+
+	void VirtualArena::Trim()
+	{
+		std::size_t keep = RoundToGranularity( mUsed );
+		if ( keep >= mCommitted )
+			return;
+
+		DecommitNative( mBase + keep, mCommitted - keep );
+		mCommitted = keep;
+	}
+
+	void VirtualArena::Release()
+	{
+		if ( !mMapping )
+			return;
+
+		ReleaseNative( mMapping, mMappingSize );
+		mMapping = nullptr;
+		mBase = nullptr;
+		mReserved = 0;
+		mCommitted = 0;
+		mUsed = 0;
+	}
+} // namespace slc
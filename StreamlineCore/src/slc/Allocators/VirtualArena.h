@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Allocator.h"
+
+namespace slc {
+
+	struct VirtualArenaOptions
+	{
+		/// <summary>
+		/// Memory is committed in multiples of this many bytes. Rounded up to the page (or huge page) size.
+		/// </summary>
+		std::size_t commitGranularity = 64 * 1024;
+
+		/// <summary>
+		/// Back the arena with huge pages. Uses explicit MAP_HUGETLB pages when the system has them reserved
+		/// and falls back to transparent huge pages otherwise. Ignored on Windows.
+		/// </summary>
+		bool hugePages = false;
+
+		/// <summary>
+		/// Fault pages in as soon as they are committed (MAP_POPULATE), so the first write to new memory never stalls.
+		/// </summary>
+		bool prefault = false;
+
+		/// <summary>
+		/// Bytes to commit up front on construction.
+		/// </summary>
+		std::size_t initialCommit = 0;
+	};
+
+	/// <summary>
+	/// A contiguous arena backed directly by virtual memory. The whole address range is reserved up front
+	/// and pages are committed on demand as the arena grows, so the base address never changes and growing
+	/// never copies. Use it for large, long lived arenas where ::operator new would otherwise mean copying
+	/// on reallocation and lazily faulting pages in on the hot path.
+	/// </summary>
+	class VirtualArena
+	{
+	public:
+		SCONSTEXPR std::size_t HugePageSize = 2 * 1024 * 1024;
+
+		/// <summary>
+		/// Reserve reserveSize bytes of address space. If the reservation fails the arena is left empty:
+		/// IsValid() returns false and every Push returns nullptr.
+		/// </summary>
+		VirtualArena( std::size_t reserveSize, VirtualArenaOptions options = {} );
+		~VirtualArena();
+
+		VirtualArena( const VirtualArena& ) = delete;
+		VirtualArena( VirtualArena&& other ) noexcept;
+
+		auto operator=( const VirtualArena& ) = delete;
+		VirtualArena& operator=( VirtualArena&& other ) noexcept;
+
+		/// <summary>
+		/// Bump allocate size bytes, committing more of the reserved range if needed.
+		/// Returns nullptr if the reservation is exhausted.
+		/// </summary>
+		void* Push( std::size_t size, std::size_t alignment = alignof( std::max_align_t ) );
+
+		/// <summary>
+		/// Rewind the arena to a previous Used() offset. Committed pages are kept for reuse.
+		/// </summary>
+		void PopTo( std::size_t offset );
+
+		void Reset()
+		{
+			mUsed = 0;
+		}
+
+		/// <summary>
+		/// Make sure at least size bytes from the base are committed.
+		/// </summary>
+		bool Commit( std::size_t size );
+
+		/// <summary>
+		/// Return committed pages beyond the current usage (rounded up to the commit granularity) to the OS.
+		/// </summary>
+		void Trim();
+
+		Byte* Data()
+		{
+			return mBase;
+		}
+		const Byte* Data() const
+		{
+			return mBase;
+		}
+
+		std::size_t Used() const
+		{
+			return mUsed;
+		}
+		std::size_t Committed() const
+		{
+			return mCommitted;
+		}
+		std::size_t Reserved() const
+		{
+			return mReserved;
+		}
+
+		bool UsingHugePages() const
+		{
+			return mHugePagesActive;
+		}
+
+		bool IsValid() const
+		{
+			return mMapping != nullptr;
+		}
+
+	private:
+		std::size_t RoundToGranularity( std::size_t size ) const
+		{
+			return ( size + mGranularity - 1 ) / mGranularity * mGranularity;
+		}
+
+		void Release();
+
+	private:
+		Byte* mBase = nullptr;
+		void* mMapping = nullptr;
+		std::size_t mMappingSize = 0;
+
+		std::size_t mReserved = 0;
+		std::size_t mCommitted = 0;
+		std::size_t mUsed = 0;
+		std::size_t mGranularity = 0;
+
+		VirtualArenaOptions mOptions;
+		bool mHugePagesActive = false;
+	};
+
+	/// <summary>
+	/// Allocator over a VirtualArena. Allocations are bump allocated with any size; freeing the most
+	/// recent allocation pops it, anything else is reclaimed on Reset. ForceReallocate just commits
+	/// more of the reservation, so existing allocations never move.
+	/// </summary>
+	class ArenaAllocator final : public AllocatorBase< ArenaAllocator >
+	{
+	public:
+		SCONSTEXPR bool DeallocateLastOnly = true;
+
+		ArenaAllocator( std::size_t reserveSize, VirtualArenaOptions options = {} )
+			: mArena( reserveSize, options )
+		{}
+
+		std::size_t MaxSize() const
+		{
+			return mArena.Reserved();
+		}
+
+		void Reset()
+		{
+			mArena.Reset();
+			mLastAllocation = nullptr;
+		}
+
+		void ForceReallocate()
+		{
+			mArena.Commit( std::min( mArena.Committed() * SCALE_FACTOR, mArena.Reserved() ) );
+		}
+
+		VirtualArena& GetArena()
+		{
+			return mArena;
+		}
+
+		void* Allocate( size_t size )
+		{
+			std::size_t offset = mArena.Used();
+			void* ptr = mArena.Push( size );
+			if ( ptr )
+			{
+				mLastAllocation = ptr;
+				mLastOffset = offset;
+			}
+			return ptr;
+		}
+
+		void Deallocate( void* ptr )
+		{
+			if ( ptr && ptr == mLastAllocation )
+			{
+				mArena.PopTo( mLastOffset );
+				mLastAllocation = nullptr;
+			}
+		}
+
+	private:
+		VirtualArena mArena;
+		void* mLastAllocation = nullptr;
+		std::size_t mLastOffset = 0;
+	};
+} // namespace slc
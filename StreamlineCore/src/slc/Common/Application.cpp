@@ -33,11 +33,15 @@ namespace slc {
 			delete layer;
 		}
 
+		RefReleaseQueue::Drain();
+
 		mImGuiController.reset();
 		mWindow.reset();
 
 		for ( const auto& shutdownTask : mAppSystems | std::views::reverse )
 			shutdownTask();
+
+		RefReleaseQueue::Drain();
 	}
 
 	void Application::OnEvent( Event& e )
@@ -119,6 +123,9 @@ namespace slc {
 
 			// Poll GLFW events to populate queue and swap buffers
 			sInstance->mWindow->OnUpdate();
+
+			// Destroy objects whose last reference was released during the frame with deferred release enabled
+			RefReleaseQueue::Drain();
 		}
 
 		delete sInstance;
@@ -17,7 +17,7 @@ namespace slc::Environment {
 #endif
 		if ( error )
 		{
-			Log::Error( "Could not set the environment variable!" );
+			SLC_LOG_ERROR( "Could not set the environment variable!" );
 		}
 	}
 
@@ -29,7 +29,7 @@ namespace slc::Environment {
 
 		if ( error )
 		{
-			Log::Error( "Could not get the environment variable" );
+			SLC_LOG_ERROR( "Could not get the environment variable" );
 			return {};
 		}
 
@@ -38,7 +38,7 @@ namespace slc::Environment {
 
 		if ( error )
 		{
-			Log::Error( "Could not get the environment variable" );
+			SLC_LOG_ERROR( "Could not get the environment variable" );
 			return {};
 		}
 
@@ -2,24 +2,110 @@
 
 #include "Macros.h"
 
+#include "slc/Allocators/SlabAllocator.h"
+#include "slc/Threading/ThreadPool.h"
+
+namespace slc {
+
+	void RefReleaseQueue::Push( void* object, DestroyFunc destroy )
+	{
+		std::scoped_lock< std::mutex > lock( sMutex );
+		sPending.push_back( { object, destroy } );
+
+		sStats.deferred_count++;
+		sStats.pending_count = sPending.size();
+		sStats.peak_pending_count = std::max( sStats.peak_pending_count, sStats.pending_count );
+	}
+
+	std::size_t RefReleaseQueue::Drain()
+	{
+		std::size_t released = 0;
+
+		// Destroying an object can release the last reference to others, so keep going until nothing new is queued.
+		for ( auto pending = TakePending(); !pending.empty(); pending = TakePending() )
+		{
+			released += pending.size();
+			Release( pending );
+		}
+
+		return released;
+	}
+
+	void RefReleaseQueue::DrainAsync( ThreadPool& pool )
+	{
+		auto pending = TakePending();
+		if ( pending.empty() )
+			return;
+
+		// Only release the batch taken here. Anything pending now, or pushed by these releases, may belong to
+		// another thread, so it waits in the queue for the next drain.
+		pool.Queue( [ pending = std::move( pending ) ]() mutable { Release( pending ); } );
+	}
+
+	RefReleaseStats RefReleaseQueue::GetStats()
+	{
+		std::scoped_lock< std::mutex > lock( sMutex );
+		return sStats;
+	}
+
+	std::vector< RefReleaseQueue::PendingRelease > RefReleaseQueue::TakePending()
+	{
+		std::scoped_lock< std::mutex > lock( sMutex );
+		if ( !sPending.empty() )
+			sStats.drain_count++;
+
+		std::vector< PendingRelease > pending = std::move( sPending );
+		sPending.clear();
+		sStats.pending_count = 0;
+		return pending;
+	}
+
+	void RefReleaseQueue::Release( std::vector< PendingRelease >& pending )
+	{
+		for ( const auto& [ object, destroy ] : pending )
+			destroy( object );
+
+		std::scoped_lock< std::mutex > lock( sMutex );
+		sStats.released_count += pending.size();
+	}
+} // namespace slc
+
 namespace slc::detail {
 
-	bool RefTracker::IsTracked( void* data )
+	WeakControlBlock* WeakControlBlock::Create( const void* object )
+	{
+		void* memory = SlabAllocator::Allocate( sizeof( WeakControlBlock ) );
+		if ( !memory )
+			throw std::bad_alloc();
+
+		return new ( memory ) WeakControlBlock( object );
+	}
+
+	void WeakControlBlock::ReleaseWeakRef()
+	{
+		if ( mWeakCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+		{
+			this->~WeakControlBlock();
+			SlabAllocator::Deallocate( this, sizeof( WeakControlBlock ) );
+		}
+	}
+
+	void WeakControlBlock::Expire()
 	{
-		ASSERT( data, "Data is null!" );
-		return sRefSet.count( data ) != 0;
+		Acquire();
+		mObject.store( nullptr, std::memory_order_release );
+		Release();
 	}
 
-	void RefTracker::AddToReferenceTracker( void* data )
+	void WeakControlBlock::Acquire()
 	{
-		ASSERT( data );
-		sRefSet.insert( data );
+		while ( mLock.test_and_set( std::memory_order_acquire ) )
+			mLock.wait( true, std::memory_order_relaxed );
 	}
 
-	void RefTracker::RemoveFromReferenceTracker( void* data )
+	void WeakControlBlock::Release()
 	{
-		ASSERT( data, "Data is null!" );
-		ASSERT( sRefSet.contains( data ), "Ref not being tracked!" );
-		sRefSet.erase( data );
+		mLock.clear( std::memory_order_release );
+		mLock.notify_one();
 	}
-} // namespace slc::detail
\ No newline at end of file
+} // namespace slc::detail
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <unordered_set>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace slc {
 
@@ -19,61 +21,353 @@ namespace slc {
 
 	// Shared Pointer
 
-	class RefCounted;
+	/// <summary>
+	/// Reference count policy for objects shared between threads. Increments are relaxed since taking a new
+	/// reference needs an existing one; decrements are acq_rel so the thread that releases the last reference
+	/// sees every write made through the others before destroying the object.
+	/// </summary>
+	struct AtomicRefCount
+	{
+		using Counter = std::atomic_uint64_t;
+
+		static uint64_t Load( const Counter& count )
+		{
+			return count.load( std::memory_order_relaxed );
+		}
+
+		static void Increment( Counter& count )
+		{
+			count.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		/// <returns>The count after decrementing</returns>
+		static uint64_t Decrement( Counter& count )
+		{
+			return count.fetch_sub( 1, std::memory_order_acq_rel ) - 1;
+		}
+
+		static bool IncrementIfNonZero( Counter& count )
+		{
+			uint64_t current = count.load( std::memory_order_relaxed );
+			while ( current != 0 )
+			{
+				if ( count.compare_exchange_weak( current, current + 1, std::memory_order_acq_rel, std::memory_order_relaxed ) )
+					return true;
+			}
+			return false;
+		}
+	};
+
+	/// <summary>
+	/// Reference count policy for objects that are only ever referenced from one thread. Plain integer arithmetic, no atomics.
+	/// </summary>
+	struct LocalRefCount
+	{
+		using Counter = uint64_t;
+
+		static uint64_t Load( const Counter& count )
+		{
+			return count;
+		}
+
+		static void Increment( Counter& count )
+		{
+			++count;
+		}
+
+		static uint64_t Decrement( Counter& count )
+		{
+			return --count;
+		}
+
+		static bool IncrementIfNonZero( Counter& count )
+		{
+			if ( count == 0 )
+				return false;
+
+			++count;
+			return true;
+		}
+	};
+
+	template < typename TPolicy >
+	class BasicRefCounted;
 
 	template < typename T >
-	concept RefCountable = std::derived_from< T, RefCounted >;
+	concept RefCountable = std::derived_from< T, BasicRefCounted< typename T::RefCountPolicy > >;
 
 	namespace detail {
 
+		struct AdoptRefTag
+		{};
+
+		/// <summary>
+		/// Records where an object created by Ref::CreateIn came from, so the last release can destroy it
+		/// and hand the block back to the same allocator.
+		/// </summary>
+		struct AllocatorOwner
+		{
+			using ReleaseFn = void ( * )( void* allocator, void* block );
+
+			void* allocator = nullptr;
+			void* block = nullptr;
+			ReleaseFn release = nullptr;
+		};
+
+		template < typename TAllocator >
+		concept SizedDeallocator = requires( TAllocator& allocator, std::size_t size, void* ptr ) { allocator.Deallocate( ptr, size ); };
+
+		/// <summary>
+		/// Allocators that can free any one block on its own. Arenas whose Deallocate frees everything and stacks
+		/// that only free the latest block are rejected, as releasing one Ref would free or pin the others.
+		/// </summary>
+		template < typename TAllocator >
+		concept RefAllocator = requires( TAllocator& allocator, std::size_t size, void* ptr ) {
+			{ allocator.Allocate( size ) } -> std::convertible_to< void* >;
+		} && ( SizedDeallocator< TAllocator > || requires( TAllocator& allocator, void* ptr ) { allocator.Deallocate( ptr ); } )
+			&& !requires { requires TAllocator::DeallocateReleasesAll; } && !requires { requires TAllocator::DeallocateLastOnly; };
+
+		/// <summary>
+		/// Shared state between an object and its weak references. Created lazily the first time a WeakRef
+		/// is taken, so weak references add only the control block pointer to each object until one is used.
+		/// The base itself is larger than that: alongside the count it holds that pointer, an AllocatorOwner
+		/// (three pointers) and the deferred release flag.
+		/// The block outlives the object for as long as any WeakRef still points at it.
+		/// </summary>
+		class WeakControlBlock
+		{
+		public:
+			WeakControlBlock( const void* object )
+				: mObject( object )
+			{}
+
+			/// <summary>
+			/// Control blocks are small and churn with weak references, so they are pooled in the slab allocator rather than heap allocated.
+			/// </summary>
+			static WeakControlBlock* Create( const void* object );
+
+			bool Expired() const
+			{
+				return mObject.load( std::memory_order_acquire ) == nullptr;
+			}
+
+			void AddWeakRef()
+			{
+				mWeakCount.fetch_add( 1, std::memory_order_relaxed );
+			}
+
+			/// <summary>
+			/// Drop a weak reference, deleting the block once the last one (including the object's own) is gone.
+			/// </summary>
+			void ReleaseWeakRef();
+
+			/// <summary>
+			/// Take a strong reference to the object if it has not been released yet.
+			/// The lock keeps the object from being expired and destroyed between the check and the increment.
+			/// </summary>
+			template < typename Func >
+			bool TryLock( Func&& tryIncrement )
+			{
+				Acquire();
+				bool locked = mObject.load( std::memory_order_relaxed ) && tryIncrement();
+				Release();
+				return locked;
+			}
+
+			void Expire();
+
+		private:
+			void Acquire();
+			void Release();
+
+		private:
+			std::atomic< const void* > mObject;
+			// One count is held by the object itself until it is destroyed.
+			std::atomic_uint32_t mWeakCount = 1;
+			std::atomic_flag mLock;
+		};
+
+		template < typename TPolicy >
 		class RefCountedBase
 		{
 		public:
+			using RefCountPolicy = TPolicy;
+
+			~RefCountedBase()
+			{
+				// Objects that were never owned by a Ref (or were destroyed directly) still need to invalidate their weak references.
+				if ( WeakControlBlock* control = mWeakControl.load( std::memory_order_acquire ) )
+				{
+					control->Expire();
+					control->ReleaseWeakRef();
+				}
+			}
+
 			uint64_t GetRefCount() const
 			{
-				return mRefCount;
+				return TPolicy::Load( mRefCount );
+			}
+
+			/// <summary>
+			/// When enabled, releasing the last reference hands the object to RefReleaseQueue instead of destroying it
+			/// in place. Use for objects that are expensive to free (large buffers, textures) and may be released on a hot path.
+			/// </summary>
+			void SetDeferredRelease( bool defer ) const
+			{
+				mDeferredRelease = defer;
+			}
+			bool IsDeferredRelease() const
+			{
+				return mDeferredRelease;
 			}
 
 		protected:
 			void IncRefCount() const
 			{
-				++mRefCount;
+				TPolicy::Increment( mRefCount );
+			}
+
+			/// <returns>The count after decrementing. The caller owns destruction when this is zero.</returns>
+			uint64_t DecRefCount() const
+			{
+				return TPolicy::Decrement( mRefCount );
+			}
+
+			/// <summary>
+			/// Increment the count only if the object is still alive. Used when locking a weak reference.
+			/// </summary>
+			bool TryIncRefCount() const
+			{
+				return TPolicy::IncrementIfNonZero( mRefCount );
+			}
+
+			/// <summary>
+			/// Returns the weak control block with its weak count incremented, creating it on first use.
+			/// </summary>
+			WeakControlBlock* AcquireWeakControl() const
+			{
+				WeakControlBlock* control = mWeakControl.load( std::memory_order_acquire );
+				if ( !control )
+				{
+					auto* created = WeakControlBlock::Create( this );
+					if ( mWeakControl.compare_exchange_strong( control, created, std::memory_order_acq_rel, std::memory_order_acquire ) )
+						control = created;
+					else
+						created->ReleaseWeakRef();
+				}
+
+				control->AddWeakRef();
+				return control;
+			}
+
+			/// <summary>
+			/// Invalidate all weak references. Called once the last strong reference is released, before destruction.
+			/// </summary>
+			void ExpireWeakRefs() const
+			{
+				if ( WeakControlBlock* control = mWeakControl.load( std::memory_order_acquire ) )
+					control->Expire();
+			}
+
+			void SetAllocatorOwner( const AllocatorOwner& owner ) const
+			{
+				mOwner = owner;
 			}
-			void DecRefCount() const
+
+			/// <summary>
+			/// Destroy the object and return its memory to the allocator it was created in.
+			/// Returns false if it was created with new, in which case the caller should delete it.
+			/// </summary>
+			bool ReleaseToAllocator() const
 			{
-				--mRefCount;
+				if ( !mOwner.release )
+					return false;
+
+				// Copy out first, the owner record is destroyed along with the object.
+				AllocatorOwner owner = mOwner;
+				owner.release( owner.allocator, owner.block );
+				return true;
 			}
 
 		private:
-			mutable std::atomic_uint64_t mRefCount = 0;
+			mutable typename TPolicy::Counter mRefCount = 0;
+			mutable std::atomic< WeakControlBlock* > mWeakControl = nullptr;
+			mutable AllocatorOwner mOwner;
+			mutable bool mDeferredRelease = false;
 		};
 	} // namespace detail
 
-	class RefCounted : public virtual detail::RefCountedBase
+	template < typename TPolicy >
+	class BasicRefCounted : public virtual detail::RefCountedBase< TPolicy >
 	{
 		template < RefCountable T >
 		friend class Ref;
+		template < RefCountable T >
+		friend class WeakRef;
 	};
 
-	namespace detail {
+	/// <summary>
+	/// Base for objects owned through Ref. Counts are atomic so references can be shared across threads.
+	/// </summary>
+	using RefCounted = BasicRefCounted< AtomicRefCount >;
 
-		class RefTracker
-		{
-		public:
-			static bool IsTracked( void* data );
+	/// <summary>
+	/// Base for objects that are only referenced from a single thread, avoiding atomic read-modify-writes on every copy.
+	/// </summary>
+	using LocalRefCounted = BasicRefCounted< LocalRefCount >;
 
-		private:
-			static void AddToReferenceTracker( void* data );
-			static void RemoveFromReferenceTracker( void* data );
+	class ThreadPool;
 
-		private:
-			using RefSet = std::unordered_set< void* >;
-			inline static RefSet sRefSet;
+	struct RefReleaseStats
+	{
+		std::size_t deferred_count{};
+		std::size_t released_count{};
+		std::size_t pending_count{};
+		std::size_t peak_pending_count{};
+		std::size_t drain_count{};
+	};
+
+	/// <summary>
+	/// Holds objects with deferred release enabled whose last reference has gone, until they are destroyed at
+	/// a chosen point. The Application drains it at the end of every frame. Objects released while draining
+	/// (e.g. children held by a destroyed object) are drained in the same call.
+	/// </summary>
+	class RefReleaseQueue
+	{
+	public:
+		using DestroyFunc = void ( * )( void* object );
+
+		static void Push( void* object, DestroyFunc destroy );
 
-			template < RefCountable T >
-			friend class Ref;
+		/// <summary>
+		/// Destroy everything pending on the calling thread. Returns the number of objects destroyed.
+		/// </summary>
+		static std::size_t Drain();
+
+		/// <summary>
+		/// Hand everything pending to a worker in the pool. Only for objects that may be destroyed off the
+		/// main thread; graphics resources must be drained on the thread that owns the context. Objects released
+		/// by the worker's destructors are queued again for the next drain rather than destroyed on the worker.
+		/// </summary>
+		static void DrainAsync( ThreadPool& pool );
+
+		static RefReleaseStats GetStats();
+
+	private:
+		struct PendingRelease
+		{
+			void* object;
+			DestroyFunc destroy;
 		};
-	} // namespace detail
+
+		static std::vector< PendingRelease > TakePending();
+		static void Release( std::vector< PendingRelease >& pending );
+
+	private:
+		inline static std::mutex sMutex;
+		inline static std::vector< PendingRelease > sPending;
+		inline static RefReleaseStats sStats;
+	};
 
 	template < RefCountable T >
 	class Ref
@@ -90,6 +384,9 @@ namespace slc {
 		{
 			IncRef();
 		}
+		Ref( T* data, detail::AdoptRefTag )
+			: mData( data )
+		{}
 
 		template < typename Other >
 		Ref( const Ref< Other >& other )
@@ -111,6 +408,10 @@ namespace slc {
 			IncRef();
 		}
 
+		Ref( Ref< T >&& other ) noexcept
+			: mData( std::exchange( other.mData, nullptr ) )
+		{}
+
 		~Ref()
 		{
 			DecRef();
@@ -142,6 +443,16 @@ namespace slc {
 			return *this;
 		}
 
+		Ref& operator=( Ref< T >&& other ) noexcept
+		{
+			if ( this != &other )
+			{
+				DecRef();
+				mData = std::exchange( other.mData, nullptr );
+			}
+			return *this;
+		}
+
 		template < typename Other >
 		Ref& operator=( Ref< Other >&& other )
 		{
@@ -211,6 +522,73 @@ namespace slc {
 			return Ref< T >( new T( std::forward< Args >( args )... ) );
 		}
 
+		/// <summary>
+		/// Construct the object in memory from the given allocator: any type with Allocate(size) and Deallocate(ptr)
+		/// or Deallocate(ptr, size) that frees blocks one at a time, such as PoolAllocator, SlabAllocator or an IAllocator
+		/// over one (see detail::RefAllocator). When the last reference is released the object is destroyed and its block
+		/// returned to the same allocator, which must outlive it and must not move its blocks (e.g. by ForceReallocate).
+		///
+		/// Returns nullptr if the allocation fails, or if a type erased allocator reports that it cannot free single blocks.
+		/// The block is handed back if the constructor throws.
+		/// </summary>
+		template < detail::RefAllocator TAllocator, typename... Args >
+		static Ref< T > CreateIn( TAllocator& allocator, Args&&... args )
+		{
+			// Type erased allocators can only tell at runtime whether they free blocks one at a time.
+			if constexpr ( requires { allocator.DeallocateReleasesAll(); allocator.DeallocateLastOnly(); } )
+			{
+				if ( allocator.DeallocateReleasesAll() || allocator.DeallocateLastOnly() )
+					return nullptr;
+			}
+
+			void* block = allocator.Allocate( BlockSize() );
+			if ( !block )
+				return nullptr;
+
+			struct BlockGuard
+			{
+				TAllocator* allocator;
+				void* block;
+
+				~BlockGuard()
+				{
+					if ( block )
+						DeallocateBlock( allocator, block );
+				}
+			} guard{ &allocator, block };
+
+			T* data = new ( AlignBlock( block ) ) T( std::forward< Args >( args )... );
+			guard.block = nullptr;
+
+			data->SetAllocatorOwner( { &allocator, block, []( void* owner, void* ptr ) {
+										  std::launder( static_cast< T* >( AlignBlock( ptr ) ) )->~T();
+										  DeallocateBlock( static_cast< TAllocator* >( owner ), ptr );
+									  } } );
+			return Ref< T >( data );
+		}
+
+	private:
+		// Allocators return blocks aligned for any fundamental type, so only over-aligned types need room to align in.
+		static constexpr std::size_t BlockSize()
+		{
+			return alignof( T ) > alignof( std::max_align_t ) ? sizeof( T ) + alignof( T ) - 1 : sizeof( T );
+		}
+
+		static void* AlignBlock( void* block )
+		{
+			auto address = reinterpret_cast< std::uintptr_t >( block );
+			return reinterpret_cast< void* >( ( address + alignof( T ) - 1 ) & ~( alignof( T ) - 1 ) );
+		}
+
+		template < typename TAllocator >
+		static void DeallocateBlock( TAllocator* allocator, void* block )
+		{
+			if constexpr ( detail::SizedDeallocator< TAllocator > )
+				allocator->Deallocate( block, BlockSize() );
+			else
+				allocator->Deallocate( block );
+		}
+
 	private:
 		void IncRef() const
 		{
@@ -218,7 +596,6 @@ namespace slc {
 				return;
 
 			mData->IncRefCount();
-			detail::RefTracker::AddToReferenceTracker( static_cast< void* >( mData ) );
 		}
 
 		void DecRef()
@@ -226,15 +603,24 @@ namespace slc {
 			if ( !mData )
 				return;
 
-			mData->DecRefCount();
-			if ( mData->GetRefCount() == 0 )
+			if ( mData->DecRefCount() == 0 )
 			{
-				delete mData;
-				detail::RefTracker::RemoveFromReferenceTracker( static_cast< void* >( mData ) );
+				mData->ExpireWeakRefs();
+				if ( mData->IsDeferredRelease() )
+					RefReleaseQueue::Push( static_cast< void* >( mData ), &Ref::Destroy );
+				else
+					Destroy( mData );
 				mData = nullptr;
 			}
 		}
 
+		static void Destroy( void* object )
+		{
+			T* data = static_cast< T* >( object );
+			if ( !data->ReleaseToAllocator() )
+				delete data;
+		}
+
 	private:
 		template < RefCountable Other >
 		friend class Ref;
@@ -251,14 +637,39 @@ namespace slc {
 	public:
 		WeakRef() = default;
 
-		WeakRef( Ref< T > ref )
+		WeakRef( const Ref< T >& ref )
+			: WeakRef( const_cast< T* >( ref.Data() ) )
+		{}
+
+		WeakRef( T* instance )
+			: mData( instance )
+			, mControl( instance ? instance->AcquireWeakControl() : nullptr )
+		{}
+
+		WeakRef( const WeakRef& other )
+			: mData( other.mData )
+			, mControl( other.mControl )
 		{
-			mData = ref.Data();
+			if ( mControl )
+				mControl->AddWeakRef();
 		}
 
-		WeakRef( T* instance )
+		WeakRef( WeakRef&& other ) noexcept
+			: mData( std::exchange( other.mData, nullptr ) )
+			, mControl( std::exchange( other.mControl, nullptr ) )
+		{}
+
+		~WeakRef()
 		{
-			mData = instance;
+			if ( mControl )
+				mControl->ReleaseWeakRef();
+		}
+
+		WeakRef& operator=( WeakRef other ) noexcept
+		{
+			std::swap( mData, other.mData );
+			std::swap( mControl, other.mControl );
+			return *this;
 		}
 
 		T* operator->()
@@ -281,7 +692,7 @@ namespace slc {
 
 		bool Valid() const
 		{
-			return mData ? detail::RefTracker::IsTracked( mData ) : false;
+			return mControl ? !mControl->Expired() : false;
 		}
 		operator bool() const
 		{
@@ -290,11 +701,15 @@ namespace slc {
 
 		Ref< T > Lock() const
 		{
-			return Ref< T >( mData );
+			if ( !mControl || !mControl->TryLock( [ this ] { return mData->TryIncRefCount(); } ) )
+				return nullptr;
+
+			return Ref< T >( mData, detail::AdoptRefTag{} );
 		}
 
 	private:
 		T* mData = nullptr;
+		detail::WeakControlBlock* mControl = nullptr;
 	};
 } // namespace slc
 
@@ -12,6 +12,8 @@ namespace slc {
 			: width( w ), height( h )
 		{}
 
+		SCONSTEXPR EventCoalescing Coalescing = EventCoalescing::KeepLast;
+
 		EVENT_DATA_TYPE( WindowResize )
 	};
 
@@ -38,6 +40,8 @@ namespace slc {
 			: xpos( x ), ypos( y )
 		{}
 
+		SCONSTEXPR EventCoalescing Coalescing = EventCoalescing::KeepLast;
+
 		EVENT_DATA_TYPE( WindowMoved )
 	};
 
@@ -27,6 +27,44 @@ namespace slc {
 		{ T::GetStaticType() } -> std::same_as< EventTypeFlag >;
 	};
 
+	/// <summary>
+	/// Events that can be written to and read back from an event trace byte for byte.
+	/// </summary>
+	template < typename T >
+	concept RecordableEvent = IsEvent< T > and std::is_trivially_copyable_v< T >;
+
+	/// <summary>
+	/// How repeated events of one type posted back to back within a frame are combined. Event types choose a default by
+	/// declaring a static constexpr EventCoalescing Coalescing member, and it can be overridden per type at runtime
+	/// with EventManager::SetCoalescing.
+	/// </summary>
+	enum class EventCoalescing
+	{
+		// Queue every event. The default.
+		KeepAll,
+		// Replace the previous event with the new one, e.g. positions where only the latest value matters.
+		KeepLast,
+		// Fold the new event into the previous one with its Accumulate method, e.g. scroll deltas.
+		SumDeltas
+	};
+
+	template < typename T >
+	concept AccumulatableEvent = IsEvent< T > and requires( T& event, const T& other ) { event.Accumulate( other ); };
+
+	template < IsEvent T >
+	constexpr EventCoalescing DefaultCoalescing()
+	{
+		if constexpr ( requires { { T::Coalescing } -> std::convertible_to< EventCoalescing >; } )
+		{
+			SASSERT( T::Coalescing != EventCoalescing::SumDeltas || AccumulatableEvent< T >, "Event type cannot sum deltas without an Accumulate method" );
+			return T::Coalescing;
+		}
+		else
+		{
+			return EventCoalescing::KeepAll;
+		}
+	}
+
 	/// <summary>
 	/// Type erasure interface base class with access methods for metadata.
 	/// </summary>
@@ -122,12 +160,12 @@ namespace slc {
 			EventModel< T >* pImpl = static_cast< EventModel< T >* >( mImpl );
 			bool handled = func( pImpl->object );
 
-			mImpl->SetHandled( handled );
+			SetHandled( handled );
 		}
 
 		bool IsHandled() const
 		{
-			return mImpl->Handled();
+			return mHandledOverride ? *mHandledOverride : mImpl->Handled();
 		}
 		EventTypeFlag GetType() const
 		{
@@ -140,13 +178,51 @@ namespace slc {
 		// more generally than for individual event types.
 		void SetHandled( bool handled = true )
 		{
-			mImpl->SetHandled( handled );
+			if ( mHandledOverride )
+				*mHandledOverride = handled;
+			else
+				mImpl->SetHandled( handled );
+		}
+
+		/// <summary>
+		/// Copy of this event that tracks its handled state in external storage, so parallel dispatch groups
+		/// can each handle the same event independently without writing to the shared model.
+		/// </summary>
+		Event WithHandledFlag( bool* handled ) const
+		{
+			Event event = *this;
+			event.mHandledOverride = handled;
+			return event;
+		}
+
+		/// <summary>
+		/// Access the underlying event if it is of type T, otherwise nullptr.
+		/// </summary>
+		template < IsEvent T >
+		T* As()
+		{
+			if ( GetType() != T::GetStaticType() )
+				return nullptr;
+
+			return &static_cast< EventModel< T >* >( mImpl )->object;
+		}
+
+		/// <summary>
+		/// Overwrite the event data in place, keeping the metadata valid. The event must already be of type T.
+		/// </summary>
+		template < IsEvent T >
+		void Replace( T&& event )
+		{
+			static_cast< EventModel< T >* >( mImpl )->object = std::move( event );
+			mImpl->SetType< T >();
 		}
 
 		friend class ImGuiController;
+		friend class EventManager;
 
 	private:
 		EventConcept* mImpl;
+		bool* mHandledOverride = nullptr;
 	};
 
 } // namespace slc
\ No newline at end of file
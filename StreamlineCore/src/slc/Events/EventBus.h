@@ -0,0 +1,204 @@
+#pragma once
+
+#include "EventTypeIndex.h"
+
+namespace slc {
+
+	struct EventSubscription
+	{
+		EventTypeSlot slot = Limits< EventTypeSlot >::Max;
+		uint32_t id = 0;
+
+		bool Valid() const
+		{
+			return slot != Limits< EventTypeSlot >::Max;
+		}
+	};
+
+	/// <summary>
+	/// Typed event queue that stores each event type in its own contiguous array, as an alternative to the
+	/// type erased EventManager queue. Subscribers receive every event of their type posted since the last
+	/// Dispatch as one span, so per-event handling is a plain loop over tightly packed data with no virtual
+	/// calls or per-listener type checks. The cost is that ordering is only kept between events of one type;
+	/// types are dispatched one after another in the order each was first posted that frame.
+	///
+	/// Not thread safe. Post, Subscribe and Dispatch should all happen on one thread. Events posted from a
+	/// subscriber during Dispatch are delivered on the next Dispatch.
+	/// </summary>
+	class EventBus
+	{
+	public:
+		template < IsEvent T >
+		using BatchHandler = Action< std::span< const T > >;
+
+	public:
+		EventBus() = default;
+
+		EventBus( const EventBus& ) = delete;
+		auto operator=( const EventBus& ) = delete;
+
+		template < IsEvent T, typename... Args >
+			requires std::constructible_from< T, Args... >
+		void Post( Args&&... args )
+		{
+			auto& channel = GetChannel< T >();
+			if ( channel.events.empty() )
+				mPendingSlots.push_back( EventTypeIndex::Get< T >() );
+
+			channel.events.emplace_back( std::forward< Args >( args )... );
+		}
+
+		template < IsEvent T, typename Func >
+			requires std::invocable< Func, std::span< const T > >
+		EventSubscription Subscribe( Func&& handler )
+		{
+			auto& channel = GetChannel< T >();
+			uint32_t id = ++mNextSubscriptionId;
+			channel.Subscribe( { id, BatchHandler< T >( std::forward< Func >( handler ) ) } );
+			return { EventTypeIndex::Get< T >(), id };
+		}
+
+		/// <summary>
+		/// Stop a subscription. Safe to call from inside a handler; the handler is not called again.
+		/// Subscribing from inside a handler is also safe; the new handler first runs on the next Dispatch.
+		/// </summary>
+		void Unsubscribe( EventSubscription& subscription )
+		{
+			if ( subscription.Valid() && subscription.slot < mChannels.size() && mChannels[ subscription.slot ] )
+				mChannels[ subscription.slot ]->Unsubscribe( subscription.id );
+
+			subscription = {};
+		}
+
+		/// <summary>
+		/// Deliver every event posted since the last call, one batch per event type, and clear the queues.
+		/// </summary>
+		void Dispatch()
+		{
+			// Swap out so subscribers posting new events do not extend the list being walked.
+			std::swap( mPendingSlots, mDispatchingSlots );
+			for ( EventTypeSlot slot : mDispatchingSlots )
+				mChannels[ slot ]->Dispatch();
+
+			mDispatchingSlots.clear();
+		}
+
+		template < IsEvent T >
+		size_t Pending() const
+		{
+			const EventTypeSlot slot = EventTypeIndex::Get< T >();
+			return slot < mChannels.size() && mChannels[ slot ] ? static_cast< const Channel< T >& >( *mChannels[ slot ] ).events.size() : 0;
+		}
+
+	private:
+		struct IChannel
+		{
+			virtual ~IChannel() = default;
+
+			virtual void Dispatch() = 0;
+			virtual void Unsubscribe( uint32_t id ) = 0;
+		};
+
+		template < IsEvent T >
+		struct Channel final : public IChannel
+		{
+			struct Subscriber
+			{
+				uint32_t id;
+				BatchHandler< T > handler;
+				// Set by Unsubscribe. The handler itself is only dropped once no handler is running, as it may be the caller.
+				bool removed = false;
+			};
+
+			std::vector< T > events;
+			std::vector< T > dispatching;
+			std::vector< Subscriber > subscribers;
+			// Subscriptions made while dispatching, appended once the handlers are done so the one running is never moved.
+			std::vector< Subscriber > addedSubscribers;
+			bool removedSubscribers = false;
+			bool dispatchingHandlers = false;
+
+			void Dispatch() override
+			{
+				std::swap( events, dispatching );
+
+				dispatchingHandlers = true;
+				const std::span< const T > batch( dispatching );
+				for ( size_t i = 0; i < subscribers.size(); ++i )
+				{
+					if ( !subscribers[ i ].removed )
+						subscribers[ i ].handler( batch );
+				}
+				dispatchingHandlers = false;
+
+				// Keep the capacity for the next frame.
+				dispatching.clear();
+
+				if ( removedSubscribers )
+				{
+					std::erase_if( subscribers, []( const Subscriber& subscriber ) { return subscriber.removed; } );
+					removedSubscribers = false;
+				}
+
+				if ( !addedSubscribers.empty() )
+				{
+					for ( Subscriber& subscriber : addedSubscribers )
+					{
+						if ( !subscriber.removed )
+							subscribers.push_back( std::move( subscriber ) );
+					}
+					addedSubscribers.clear();
+				}
+			}
+
+			void Subscribe( Subscriber&& subscriber )
+			{
+				if ( dispatchingHandlers )
+					addedSubscribers.push_back( std::move( subscriber ) );
+				else
+					subscribers.push_back( std::move( subscriber ) );
+			}
+
+			void Unsubscribe( uint32_t id ) override
+			{
+				if ( auto it = std::ranges::find( addedSubscribers, id, &Subscriber::id ); it != addedSubscribers.end() )
+				{
+					it->removed = true;
+					return;
+				}
+
+				auto it = std::ranges::find( subscribers, id, &Subscriber::id );
+				if ( it == subscribers.end() )
+					return;
+
+				it->removed = true;
+				removedSubscribers = true;
+
+				// Outside Dispatch nothing can be running the handler, so release its captures straight away.
+				if ( !dispatchingHandlers )
+					it->handler = nullptr;
+			}
+		};
+
+		template < IsEvent T >
+		Channel< T >& GetChannel()
+		{
+			const EventTypeSlot slot = EventTypeIndex::Get< T >();
+			if ( slot >= mChannels.size() ) [[unlikely]]
+				mChannels.resize( std::max( slot + 1, EventTypeIndex::Count() ) );
+
+			if ( !mChannels[ slot ] ) [[unlikely]]
+				mChannels[ slot ] = MakeUnique< Channel< T > >();
+
+			return static_cast< Channel< T >& >( *mChannels[ slot ] );
+		}
+
+	private:
+		// Indexed by EventTypeSlot.
+		std::vector< Unique< IChannel > > mChannels;
+
+		std::vector< EventTypeSlot > mPendingSlots;
+		std::vector< EventTypeSlot > mDispatchingSlots;
+		uint32_t mNextSubscriptionId = 0;
+	};
+} // namespace slc
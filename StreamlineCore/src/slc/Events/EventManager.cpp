@@ -3,49 +3,291 @@
 #include "slc/Common/Application.h"
 
 #include "IEventListener.h"
+#include "EventRecorder.h"
+
+#include "slc/Threading/ThreadPool.h"
+
+#include <bit>
+#include <latch>
 
 namespace slc {
 
 	void EventManager::Dispatch()
 	{
-		// Add any new listeners queued to start listening.
-		sState.genericListeners.insert( sState.genericListeners.end(), sState.newListeners.begin(), sState.newListeners.end() );
-		sState.newListeners.clear();
+		sState.dispatchThread.store( std::this_thread::get_id(), std::memory_order_relaxed );
 
-		// Remove any listeners queued to remove.
-		std::erase_if( sState.genericListeners, [ & ]( const IEventListener* listener ) { return std::ranges::contains( sState.oldListeners, listener ); } );
-		sState.oldListeners.clear();
+		// Move events posted from other threads into the queue.
+		DrainStagedEvents();
+
+		// Apply listener additions and removals queued since the last frame.
+		ApplyListenerChanges();
 
 		// Distribute events in the queue
-		for ( Event& e : sState.eventQueue )
+		sState.dispatching = true;
+		sState.handledBeforeGroups.clear();
+		for ( size_t i = 0; i < sState.eventQueue.size(); ++i )
 		{
+			Event& e = sState.eventQueue[ i ];
+
 			// Handle app events first
-			if ( sState.appListener->Accept( e ) )
+			if ( sState.appListener && sState.appListener->Accept( e ) )
 				sState.appListener->OnEvent( e );
 
 			// Handle imgui events next
-			if ( sState.imGuiListener->Accept( e ) )
+			if ( sState.imGuiListener && sState.imGuiListener->Accept( e ) )
 				sState.imGuiListener->OnEvent( e );
 
-			// Handle any generic listeners that accept this event type.
-			for ( IEventListener* listener : sState.genericListeners | std::views::filter( [ & ]( IEventListener* listener ) { return listener->Accept( e ); } ) )
-				listener->OnEvent( e );
+			// Dispatch-thread posts from these listeners extend the queue, so this grows along with it.
+			sState.handledBeforeGroups.push_back( e.IsHandled() );
+
+			// Handle the generic listeners in the bucket for this event type. Every listener in it is listening for the type.
+			const EventTypeFlag type = e.GetType();
+			if ( type == EventType::None )
+				continue;
+
+			for ( ListenerSlot* slot : sState.listenerBuckets[ std::countr_zero( type ) ] )
+			{
+				if ( e.IsHandled() )
+					break;
+
+				// Listeners removed during this frame have already had their slot cleared.
+				IEventListener* listener = slot->listener.load( std::memory_order_relaxed );
+				if ( listener && listener->AcceptCondition() )
+					listener->OnEvent( e );
+			}
+		}
+
+		// Then let each parallel group handle the frame's events independently. The queue no longer changes from here:
+		// anything posted while the groups run is staged for the next frame.
+		if ( !sState.parallelGroups.empty() )
+		{
+			sState.parallelDispatching.store( true, std::memory_order_relaxed );
+			DispatchParallelGroups();
+			sState.parallelDispatching.store( false, std::memory_order_relaxed );
 		}
 
+		sState.dispatching = false;
+		sState.frame.fetch_add( 1, std::memory_order_relaxed );
+
 		// Clear down event queue and reset event model allocators.
 		sState.eventQueue.clear();
 		sState.modelAllocator.Flush();
 	}
 
-	void EventManager::RegisterListener( IEventListener* listener, ListenerType type )
+	void EventManager::SetRecorder( EventRecorder* recorder )
+	{
+		sState.recorder.store( recorder, std::memory_order_seq_cst );
+
+		// Any Post that could still see the previous recorder has registered itself in recordersInFlight.
+		for ( uint32_t inFlight = sState.recordersInFlight.load( std::memory_order_seq_cst ); inFlight != 0; inFlight = sState.recordersInFlight.load( std::memory_order_seq_cst ) )
+			sState.recordersInFlight.wait( inFlight, std::memory_order_seq_cst );
+	}
+
+	void EventManager::RecordEvent( EventTypeFlag type, const void* data, size_t size )
+	{
+		// Register before loading the recorder. SetRecorder swaps it before checking the count, so either this
+		// sees the new recorder or SetRecorder waits for this call to finish with the old one.
+		sState.recordersInFlight.fetch_add( 1, std::memory_order_seq_cst );
+
+		if ( EventRecorder* recorder = sState.recorder.load( std::memory_order_seq_cst ) )
+			recorder->Record( GetFrame(), type, data, size );
+
+		if ( sState.recordersInFlight.fetch_sub( 1, std::memory_order_seq_cst ) == 1 )
+			sState.recordersInFlight.notify_all();
+	}
+
+	void EventManager::ApplyListenerChanges()
+	{
+		std::scoped_lock< std::mutex > lock( sState.listenerMutex );
+
+		if ( sState.newListeners.empty() && !sState.listenersRemoved && !sState.listenersInvalidated )
+			return;
+
+		// Free the slots of removed listeners. A single pass keeps the remaining listeners in order.
+		if ( sState.listenersRemoved )
+		{
+			auto isRemoved = []( uint32_t slot ) {
+				auto& entry = sState.listenerSlots[ slot ];
+				if ( entry.listener )
+					return false;
+
+				entry.generation++;
+				sState.freeListenerSlots.push_back( slot );
+				return true;
+			};
+
+			std::erase_if( sState.genericListeners, isRemoved );
+			std::erase_if( sState.newListeners, isRemoved );
+			sState.listenersRemoved = false;
+		}
+
+		sState.genericListeners.insert( sState.genericListeners.end(), sState.newListeners.begin(), sState.newListeners.end() );
+		sState.newListeners.clear();
+		sState.listenersInvalidated = false;
+
+		RebuildListenerBuckets();
+	}
+
+	void EventManager::RebuildListenerBuckets()
+	{
+		for ( auto& bucket : sState.listenerBuckets )
+			bucket.clear();
+
+		sState.parallelGroups.clear();
+
+		// Listeners stay in registration order within each bucket.
+		for ( uint32_t index : sState.genericListeners )
+		{
+			ListenerSlot* slot = &sState.listenerSlots[ index ];
+			IEventListener* listener = slot->listener.load( std::memory_order_relaxed );
+			const uint32_t groupId = listener->GetDispatchGroup();
+
+			if ( groupId == SerialDispatchGroup )
+			{
+				for ( EventTypeFlag mask = listener->GetListeningEvents(); mask != 0; mask &= mask - 1 )
+					sState.listenerBuckets[ std::countr_zero( mask ) ].push_back( slot );
+				continue;
+			}
+
+			auto group = std::ranges::find( sState.parallelGroups, groupId, &ListenerGroup::id );
+			if ( group == sState.parallelGroups.end() )
+				group = sState.parallelGroups.insert( group, ListenerGroup{ groupId } );
+
+			for ( EventTypeFlag mask = listener->GetListeningEvents(); mask != 0; mask &= mask - 1 )
+				group->buckets[ std::countr_zero( mask ) ].push_back( { slot, listener } );
+		}
+	}
+
+	void EventManager::DispatchParallelGroups()
+	{
+		// Serial listeners may have removed grouped listeners this frame. Drop them now, while nothing else is running.
+		if ( sState.listenersRemoved )
+		{
+			for ( ListenerGroup& group : sState.parallelGroups )
+			{
+				for ( auto& bucket : group.buckets )
+					std::erase_if( bucket, []( const ListenerGroup::Entry& entry ) { return !entry.slot->listener.load( std::memory_order_relaxed ); } );
+			}
+		}
+
+		const size_t count = sState.handledBeforeGroups.size();
+
+		if ( !sState.threadPool )
+		{
+			for ( ListenerGroup& group : sState.parallelGroups )
+				DispatchGroup( group, count );
+			return;
+		}
+
+		// The dispatch thread takes the first group itself rather than sitting idle.
+		std::latch done( static_cast< std::ptrdiff_t >( sState.parallelGroups.size() ) );
+		for ( size_t i = 1; i < sState.parallelGroups.size(); ++i )
+		{
+			sState.threadPool->Queue( [ &done, &group = sState.parallelGroups[ i ], count ]() {
+				DispatchGroup( group, count );
+				done.count_down();
+			} );
+		}
+
+		DispatchGroup( sState.parallelGroups.front(), count );
+		done.count_down();
+		done.wait();
+	}
+
+	void EventManager::DispatchGroup( ListenerGroup& group, size_t count )
+	{
+		auto handled = MakeUnique< bool[] >( count );
+
+		for ( size_t i = 0; i < count; ++i )
+		{
+			handled[ i ] = sState.handledBeforeGroups[ i ];
+			if ( handled[ i ] )
+				continue;
+
+			const EventTypeFlag type = sState.eventQueue[ i ].GetType();
+			if ( type == EventType::None )
+				continue;
+
+			Event e = sState.eventQueue[ i ].WithHandledFlag( &handled[ i ] );
+			for ( const auto& [ slot, listener ] : group.buckets[ std::countr_zero( type ) ] )
+			{
+				if ( handled[ i ] )
+					break;
+
+				// Publish the call before checking the slot. DeregisterListener clears the slot before checking
+				// inFlight, so either the call is skipped or the removal waits for it to return.
+				slot->inFlight.fetch_add( 1, std::memory_order_seq_cst );
+				if ( slot->listener.load( std::memory_order_seq_cst ) == listener && listener->AcceptCondition() )
+				{
+					tCallingSlot = slot;
+					listener->OnEvent( e );
+					tCallingSlot = nullptr;
+				}
+
+				if ( slot->inFlight.fetch_sub( 1, std::memory_order_seq_cst ) == 1 )
+					slot->inFlight.notify_all();
+			}
+		}
+	}
+
+	void EventManager::PushStagedEvent( StagedEvent* staged )
+	{
+		staged->next = sState.stagedEvents.load( std::memory_order_relaxed );
+		while ( !sState.stagedEvents.compare_exchange_weak( staged->next, staged, std::memory_order_release, std::memory_order_relaxed ) )
+			;
+	}
+
+	void EventManager::DrainStagedEvents()
+	{
+		StagedEvent* staged = sState.stagedEvents.exchange( nullptr, std::memory_order_acquire );
+		if ( !staged )
+			return;
+
+		// The list is most recent first, so reverse it to restore posting order.
+		StagedEvent* ordered = nullptr;
+		while ( staged )
+		{
+			StagedEvent* next = staged->next;
+			staged->next = ordered;
+			ordered = staged;
+			staged = next;
+		}
+
+		while ( ordered )
+		{
+			StagedEvent* next = ordered->next;
+			sState.eventQueue.push_back( ordered->event );
+			sState.modelAllocator.Adopt( ordered->model );
+			delete ordered;
+			ordered = next;
+		}
+	}
+
+	ListenerHandle EventManager::RegisterListener( IEventListener* listener, ListenerType type )
 	{
 		switch ( type )
 		{
 			case ListenerType::Generic:
 			{
+				std::scoped_lock< std::mutex > lock( sState.listenerMutex );
+
+				uint32_t slot;
+				if ( !sState.freeListenerSlots.empty() )
+				{
+					slot = sState.freeListenerSlots.back();
+					sState.freeListenerSlots.pop_back();
+				}
+				else
+				{
+					slot = static_cast< uint32_t >( sState.listenerSlots.size() );
+					sState.listenerSlots.emplace_back();
+				}
+
+				sState.listenerSlots[ slot ].listener = listener;
+
 				// Some events may create a new listener while we're iterating through the listeners, so postpone addition till start of new frame.
-				sState.newListeners.emplace_back( listener );
-				break;
+				sState.newListeners.push_back( slot );
+				return { slot, sState.listenerSlots[ slot ].generation };
 			}
 			case ListenerType::App:
 			{
@@ -58,6 +300,8 @@ namespace slc {
 				break;
 			}
 		}
+
+		return {};
 	}
 
 	void EventManager::DeregisterListener( IEventListener* listener, ListenerType type )
@@ -66,7 +310,25 @@ namespace slc {
 		{
 			case ListenerType::Generic:
 			{
-				sState.oldListeners.emplace_back( listener );
+				ListenerSlot* slot;
+				{
+					std::scoped_lock< std::mutex > lock( sState.listenerMutex );
+
+					ListenerHandle handle = listener->mHandle;
+					if ( !IsRegisteredUnlocked( handle ) )
+						break;
+
+					// Clear the slot now so the listener gets no more events; the slot itself is freed next Dispatch.
+					slot = &sState.listenerSlots[ handle.index ];
+					slot->listener.store( nullptr, std::memory_order_seq_cst );
+					sState.listenersRemoved = true;
+				}
+
+				// A parallel group may be inside this listener's OnEvent. Wait for it to return before the listener is
+				// destroyed, unless that call is the one removing it.
+				const uint32_t self = tCallingSlot == slot ? 1 : 0;
+				for ( uint32_t inFlight = slot->inFlight.load( std::memory_order_seq_cst ); inFlight > self; inFlight = slot->inFlight.load( std::memory_order_seq_cst ) )
+					slot->inFlight.wait( inFlight, std::memory_order_seq_cst );
 				break;
 			}
 			case ListenerType::App:
@@ -81,4 +343,25 @@ namespace slc {
 			}
 		}
 	}
+
+	bool EventManager::IsRegistered( ListenerHandle handle )
+	{
+		std::scoped_lock< std::mutex > lock( sState.listenerMutex );
+		return IsRegisteredUnlocked( handle );
+	}
+
+	void EventManager::InvalidateListeners()
+	{
+		std::scoped_lock< std::mutex > lock( sState.listenerMutex );
+		sState.listenersInvalidated = true;
+	}
+
+	bool EventManager::IsRegisteredUnlocked( ListenerHandle handle )
+	{
+		if ( !handle.Valid() || handle.index >= sState.listenerSlots.size() )
+			return false;
+
+		const auto& slot = sState.listenerSlots[ handle.index ];
+		return slot.generation == handle.generation && slot.listener != nullptr;
+	}
 } // namespace slc
\ No newline at end of file
@@ -2,14 +2,39 @@
 
 #include "EventModelAllocator.h"
 
+#include <deque>
+
 namespace slc {
 
 	class IEventListener;
+	class EventRecorder;
+	class ThreadPool;
+
+	/// <summary>
+	/// Identifies a registered listener. The generation is bumped whenever a slot is recycled,
+	/// so a stale handle never refers to a listener registered later in the same slot.
+	/// </summary>
+	struct ListenerHandle
+	{
+		SCONSTEXPR uint32_t InvalidIndex = Limits< uint32_t >::Max;
+
+		uint32_t index = InvalidIndex;
+		uint32_t generation = 0;
+
+		bool Valid() const
+		{
+			return index != InvalidIndex;
+		}
+	};
 
 	/// <summary>
 	/// The interface by which events are queued and handled. Use the Post(...) method to submit an event
 	/// to be queued, which will then be handled at the start of the next frame in the Dispatch() method.
 	///
+	/// Post may be called from any thread. Events posted from the thread that runs Dispatch are queued directly;
+	/// events from other threads are staged on a lock-free list and moved into the queue at the start of the next
+	/// Dispatch, keeping the order in which each thread posted them.
+	///
 	/// Listeners can be added by inheriting IEventListener which will automatically call Register/DeregisterListener
 	/// in its constructor/desctructor respectively. This means they should generally be heap allocated objects,
 	/// especially because addition and removal of listeners is queued to occur once per frame before dispatch.
@@ -24,13 +49,108 @@ namespace slc {
 			ImGui
 		};
 
+		SCONSTEXPR uint32_t SerialDispatchGroup = 0;
+
 	public:
-		static void RegisterListener( IEventListener* listener, ListenerType type );
+		static ListenerHandle RegisterListener( IEventListener* listener, ListenerType type );
 		static void DeregisterListener( IEventListener* listener, ListenerType type );
 
+		/// <summary>
+		/// Whether the handle refers to a generic listener that is still registered (including one waiting to be added next frame).
+		/// </summary>
+		static bool IsRegistered( ListenerHandle handle );
+
+		/// <summary>
+		/// Rebuild the dispatch tables at the start of the next Dispatch, e.g. after a listener changed dispatch group.
+		/// </summary>
+		static void InvalidateListeners();
+
+		/// <summary>
+		/// Pool used to run parallel dispatch groups. Without one, groups run one after another on the dispatch thread.
+		/// </summary>
+		static void SetThreadPool( ThreadPool* pool )
+		{
+			sState.threadPool = pool;
+		}
+
 		template < IsEvent TEvent, typename... TArgs >
 		static void Post( TArgs&&... args )
 		{
+			if constexpr ( RecordableEvent< TEvent > )
+			{
+				if ( sState.recorder.load( std::memory_order_acquire ) ) [[unlikely]]
+				{
+					TEvent event( std::forward< TArgs >( args )... );
+					RecordEvent( TEvent::GetStaticType(), &event, sizeof( TEvent ) );
+					Enqueue< TEvent >( event );
+					return;
+				}
+			}
+
+			Enqueue< TEvent >( std::forward< TArgs >( args )... );
+		}
+
+		static void Dispatch();
+
+		/// <summary>
+		/// The number of times Dispatch has run. Events posted now will be dispatched in this frame.
+		/// </summary>
+		static uint64_t GetFrame()
+		{
+			return sState.frame.load( std::memory_order_relaxed );
+		}
+
+		/// <summary>
+		/// Attach a recorder that receives every recordable event passed to Post, or nullptr to stop recording.
+		/// Returns once no Post on any thread is still using the previous recorder, so it can then be destroyed.
+		/// </summary>
+		static void SetRecorder( EventRecorder* recorder );
+
+		/// <summary>
+		/// Override the coalescing policy of an event type, which otherwise comes from its Coalescing member.
+		/// The policy is a template argument so that asking for SumDeltas on an event without an Accumulate method
+		/// fails to compile.
+		/// </summary>
+		template < IsEvent TEvent, EventCoalescing Coalescing >
+		static void SetCoalescing()
+		{
+			SASSERT( Coalescing != EventCoalescing::SumDeltas || AccumulatableEvent< TEvent >, "Event type cannot sum deltas without an Accumulate method" );
+
+			const EventTypeSlot slot = EventTypeIndex::Get< TEvent >();
+			if ( slot >= sState.coalescing.size() )
+				sState.coalescing.resize( slot + 1 );
+
+			sState.coalescing[ slot ] = Coalescing;
+		}
+
+		template < IsEvent TEvent >
+		static EventCoalescing GetCoalescing()
+		{
+			const EventTypeSlot slot = EventTypeIndex::Get< TEvent >();
+			if ( slot < sState.coalescing.size() && sState.coalescing[ slot ] )
+				return *sState.coalescing[ slot ];
+
+			return DefaultCoalescing< TEvent >();
+		}
+
+	private:
+		template < IsEvent TEvent, typename... TArgs >
+		static void Enqueue( TArgs&&... args )
+		{
+			if ( std::this_thread::get_id() != sState.dispatchThread.load( std::memory_order_relaxed ) ||
+				 sState.parallelDispatching.load( std::memory_order_relaxed ) ) [[unlikely]]
+			{
+				// The model allocator and queue belong to the dispatch thread, so hand the event over instead. The queue
+				// is also read by the parallel groups, so it is left alone while they run even on the dispatch thread.
+				auto* model = new EventModel< TEvent >( std::forward< TArgs >( args )... );
+				PushStagedEvent( new StagedEvent{ nullptr, Event( *model ), model } );
+				return;
+			}
+
+			// Fold into the previous event if it is the same type and the type coalesces.
+			if ( TryCoalesce< TEvent >( std::forward< TArgs >( args )... ) )
+				return;
+
 			// Get event model instance from allocator. Event will be constructed in place inside model.
 			EventModel< TEvent >& eventModel = sState.modelAllocator.NewModel< TEvent >( std::forward< TArgs >( args )... );
 
@@ -38,22 +158,135 @@ namespace slc {
 			sState.eventQueue.emplace_back( eventModel );
 		}
 
-		static void Dispatch();
+		static void RecordEvent( EventTypeFlag type, const void* data, size_t size );
+
+		/// <summary>
+		/// Only adjacent events are combined, so the relative order of different event types is never changed.
+		/// </summary>
+		template < IsEvent TEvent, typename... TArgs >
+		static bool TryCoalesce( TArgs&&... args )
+		{
+			if ( sState.eventQueue.empty() || sState.dispatching )
+				return false;
+
+			const EventCoalescing coalescing = GetCoalescing< TEvent >();
+			if ( coalescing == EventCoalescing::KeepAll )
+				return false;
+
+			Event& lastEvent = sState.eventQueue.back();
+			TEvent* last = lastEvent.template As< TEvent >();
+			if ( !last )
+				return false;
+
+			if ( coalescing == EventCoalescing::KeepLast )
+			{
+				lastEvent.Replace( TEvent( std::forward< TArgs >( args )... ) );
+				return true;
+			}
+
+			if constexpr ( AccumulatableEvent< TEvent > )
+			{
+				last->Accumulate( TEvent( std::forward< TArgs >( args )... ) );
+				return true;
+			}
+
+			return false;
+		}
+
+		struct StagedEvent
+		{
+			StagedEvent* next;
+			Event event;
+			EventConcept* model;
+		};
+
+		static void ApplyListenerChanges();
+		static void RebuildListenerBuckets();
+
+		struct ListenerGroup;
+		static void DispatchParallelGroups();
+		static void DispatchGroup( ListenerGroup& group, size_t count );
+
+		static bool IsRegisteredUnlocked( ListenerHandle handle );
+
+		static void PushStagedEvent( StagedEvent* staged );
+		static void DrainStagedEvents();
 
 	private:
+		// Generic listeners live in a slot map. Removal clears the slot straight away and the dense list is
+		// compacted once at the start of the next Dispatch, so add and remove are O(1) and order is kept.
+		struct ListenerSlot
+		{
+			// Atomic, with inFlight, so a listener can be removed while a parallel group may be calling it.
+			std::atomic< IEventListener* > listener = nullptr;
+			std::atomic_uint32_t inFlight = 0;
+			uint32_t generation = 0;
+		};
+
+		struct ListenerGroup
+		{
+			struct Entry
+			{
+				ListenerSlot* slot;
+				IEventListener* listener;
+			};
+
+			uint32_t id;
+			std::array< std::vector< Entry >, std::numeric_limits< EventTypeFlag >::digits > buckets;
+		};
+
 		struct EventManagerState
 		{
-			std::vector< Event > eventQueue;
+			// A deque so listeners posting on the dispatch thread do not move the event they are handling.
+			std::deque< Event > eventQueue;
 			EventModelAllocator modelAllocator;
 
 			IEventListener* appListener = nullptr;
 			IEventListener* imGuiListener = nullptr;
-			std::vector< IEventListener* > genericListeners;
 
-			std::vector< IEventListener* > newListeners;
-			std::vector< IEventListener* > oldListeners;
+			// A deque so slots never move: dispatch holds slot pointers while other threads may register listeners.
+			std::deque< ListenerSlot > listenerSlots;
+			std::vector< uint32_t > freeListenerSlots;
+
+			// Slot indices of the active generic listeners in registration order.
+			std::vector< uint32_t > genericListeners;
+
+			// Generic listeners grouped by each event type bit they listen for, indexed by the bit position.
+			// Rebuilt only when listeners are added or removed.
+			std::array< std::vector< ListenerSlot* >, std::numeric_limits< EventTypeFlag >::digits > listenerBuckets;
+
+			// Slots registered since the last Dispatch, added to the dense list at the start of the next one.
+			std::vector< uint32_t > newListeners;
+			bool listenersRemoved = false;
+			bool listenersInvalidated = false;
+
+			// Registration may happen from listeners running in parallel groups.
+			std::mutex listenerMutex;
+
+			std::vector< ListenerGroup > parallelGroups;
+			ThreadPool* threadPool = nullptr;
+
+			// Handled state of each queued event after the serial listeners, the starting point for parallel groups.
+			std::vector< char > handledBeforeGroups;
+			std::atomic_bool parallelDispatching = false;
+
+			// Events posted from other threads, most recent first.
+			std::atomic< StagedEvent* > stagedEvents = nullptr;
+
+			// Runtime coalescing overrides indexed by EventTypeSlot.
+			std::vector< std::optional< EventCoalescing > > coalescing;
+			bool dispatching = false;
+			std::atomic< std::thread::id > dispatchThread;
+
+			std::atomic< uint64_t > frame = 0;
+			std::atomic< EventRecorder* > recorder = nullptr;
+			// Posts between loading the recorder and finishing with it, so SetRecorder can wait them out.
+			std::atomic_uint32_t recordersInFlight = 0;
 		};
 
 		inline static EventManagerState sState;
+
+		// Slot whose listener this thread is calling from a parallel group, so a listener can remove itself.
+		inline static thread_local ListenerSlot* tCallingSlot = nullptr;
 	};
 } // namespace slc
\ No newline at end of file
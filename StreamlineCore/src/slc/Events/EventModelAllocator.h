@@ -1,74 +1,45 @@
 #pragma once
 
-#include "Event.h"
-
-#include "ApplicationEvent.h"
-#include "KeyEvent.h"
-#include "MouseEvent.h"
+#include "EventTypeIndex.h"
 
 #include "slc/Allocators/LinearAllocator.h"
 
 namespace slc {
 
-	namespace EventList {
-
-		using All = TypeList<
-			WindowCloseEvent,
-			WindowResizeEvent,
-			WindowFocusEvent,
-			WindowFocusLostEvent,
-			WindowMovedEvent,
-
-			AppTickEvent,
-			AppUpdateEvent,
-			AppRenderEvent,
-
-			KeyPressedEvent,
-			KeyReleasedEvent,
-			KeyTypedEvent,
-
-			MouseButtonPressedEvent,
-			MouseButtonReleasedEvent,
-			MouseMovedEvent,
-			MouseScrolledEvent >;
-	}
-
 	/// <summary>
 	/// Allocates and constructs event models for any given event type.
 	/// </summary>
 	class EventModelAllocator
 	{
 	private:
-		using TypeName = std::string_view;
 		SCONSTEXPR size_t DefaultModelChunkSize = 4;
 
+		template < IsEvent T >
+		using ModelAllocatorType = AllocatorAdapter< LinearAllocator< EventModel< T > > >;
+
 		struct ModelAllocator
 		{
 			Unique< IAllocator > allocator = nullptr;
 			size_t remaining = 0;
 
+			ModelAllocator() = default;
+
 			template < IsEvent T >
-			ModelAllocator( Unique< LinearAllocator< EventModel< T > > > alloc )
+			ModelAllocator( Unique< ModelAllocatorType< T > > alloc )
 				: allocator( std::move( alloc ) ), remaining( allocator->MaxSize() )
 			{}
 		};
 
-		using InternalAllocatorElement = std::pair< TypeName, ModelAllocator >;
-		using InternalAllocatorArray = std::array< InternalAllocatorElement, EventList::All::Size >;
-		using InternalAllocatorMap = std::map< TypeName, ModelAllocator >;
-
-		template < size_t I >
-			requires( I < EventList::All::Size )
-		static InternalAllocatorElement BuildEventAllocator()
-		{
-			using Type = EventList::All::Type< I >;
-			return std::make_pair( TypeTraits< Type >::Name, MakeUnique< LinearAllocator< EventModel< Type > > >( DefaultModelChunkSize ) );
-		}
+		// Indexed by EventTypeSlot. Built-in slots are filled on construction, custom slots on first use.
+		using InternalAllocatorArray = std::vector< ModelAllocator >;
 
 		template < size_t... Is >
 		static InternalAllocatorArray BuildAllEventAllocators( std::index_sequence< Is... > )
 		{
-			return { { BuildEventAllocator< Is >()... } };
+			InternalAllocatorArray result;
+			result.reserve( EventList::All::Size );
+			( result.emplace_back( MakeUnique< ModelAllocatorType< EventList::All::Type< Is > > >( DefaultModelChunkSize ) ), ... );
+			return result;
 		}
 
 		inline static InternalAllocatorArray BuildInternalEventAllocators()
@@ -76,19 +47,9 @@ namespace slc {
 			return BuildAllEventAllocators( std::make_index_sequence< EventList::All::Size >() );
 		}
 
-		inline static InternalAllocatorMap ConstructAllocatorMap()
-		{
-			InternalAllocatorMap result;
-			for ( auto&& [ type, allocator ] : BuildInternalEventAllocators() )
-			{
-				result.emplace( type, std::move( allocator ) );
-			}
-			return result;
-		}
-
 	public:
 		EventModelAllocator()
-			: mModelAllocators( ConstructAllocatorMap() )
+			: mModelAllocators( BuildInternalEventAllocators() )
 		{
 		}
 		~EventModelAllocator()
@@ -111,12 +72,16 @@ namespace slc {
 			requires std::constructible_from< T, Args... >
 		EventModel< T >& NewModel( Args&&... args )
 		{
-			using EventType = TypeTraits< T >;
+			const EventTypeSlot slot = EventTypeIndex::Get< T >();
 
-			if ( !mModelAllocators.contains( EventType::Name ) )
-				Register< T >();
+			// Built-in event allocators always exist, custom ones are created the first time the event is posted.
+			if constexpr ( not EventList::All::Contains< T > )
+			{
+				if ( slot >= mModelAllocators.size() || !mModelAllocators[ slot ].allocator ) [[unlikely]]
+					Register< T >( slot );
+			}
 
-			auto& model = mModelAllocators.at( EventType::Name );
+			auto& model = mModelAllocators[ slot ];
 
 			// If there is no more space in pool allocator, just use default allocator.
 			// Pointer will be saved to be cleared up on flush at which point the pool
@@ -137,8 +102,11 @@ namespace slc {
 		/// </summary>
 		void Flush()
 		{
-			for ( auto& [ type, model ] : mModelAllocators )
+			for ( auto& model : mModelAllocators )
 			{
+				if ( !model.allocator )
+					continue;
+
 				model.allocator->Reset();
 
 				// The allocator completely filled up during this frame. Reallocate larger to compensate.
@@ -153,12 +121,22 @@ namespace slc {
 			CleanupDefaultNewPointers();
 		}
 
+		/// <summary>
+		/// Take ownership of a model allocated elsewhere with new. It will be deleted on the next Flush.
+		/// </summary>
+		void Adopt( EventConcept* model )
+		{
+			mOverflowPointers.push_back( model );
+		}
+
 	private:
 		template < IsEvent T >
-		void Register()
+		void Register( EventTypeSlot slot )
 		{
-			using EventType = TypeTraits< T >;
-			mModelAllocators.try_emplace( EventType::Name, MakeUnique< LinearAllocator< EventModel< T > > >( DefaultModelChunkSize ) );
+			if ( slot >= mModelAllocators.size() )
+				mModelAllocators.resize( slot + 1 );
+
+			mModelAllocators[ slot ] = ModelAllocator( MakeUnique< ModelAllocatorType< T > >( DefaultModelChunkSize ) );
 		}
 
 		void CleanupDefaultNewPointers()
@@ -174,13 +152,15 @@ namespace slc {
 			requires std::constructible_from< T, Args... >
 		static EventModel< T >& ConstructModel( ModelAllocator& model, Args&&... args )
 		{
-			EventModel< T >* ptr = model.allocator->Alloc< EventModel< T > >( std::forward< Args >( args )... );
+			// The allocator for T is always a LinearAllocator of EventModel<T>, so skip the virtual interface and bump allocate directly.
+			auto& allocator = static_cast< ModelAllocatorType< T >& >( *model.allocator ).Get();
+			EventModel< T >* ptr = allocator.template Alloc< EventModel< T > >( std::forward< Args >( args )... );
 			model.remaining--;
 			return *ptr;
 		}
 
 	private:
-		InternalAllocatorMap mModelAllocators;
+		InternalAllocatorArray mModelAllocators;
 		std::vector< EventConcept* > mOverflowPointers;
 	};
 } // namespace slc
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "EventRecorder.h"
+
+#include "slc/Logging/Log.h"
+
+namespace slc {
+
+	EventRecorder::EventRecorder( const fs::path& path )
+		: mStream( path, std::ios::binary | std::ios::trunc )
+	{
+		if ( !mStream.is_open() )
+		{
+			SLC_CLOG_ERROR( Events, "Failed to open event trace {} for writing", path.string() );
+			return;
+		}
+
+		EventTrace::Header header;
+		mStream.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+	}
+
+	EventRecorder::~EventRecorder()
+	{
+		Stop();
+	}
+
+	void EventRecorder::Start()
+	{
+		if ( !IsOpen() )
+			return;
+
+		{
+			std::scoped_lock< std::mutex > lock( mMutex );
+			mStartFrame = EventManager::GetFrame();
+		}
+
+		EventManager::SetRecorder( this );
+	}
+
+	void EventRecorder::Stop()
+	{
+		EventManager::SetRecorder( nullptr );
+
+		std::scoped_lock< std::mutex > lock( mMutex );
+		mStream.flush();
+	}
+
+	void EventRecorder::Record( uint64_t frame, EventTypeFlag type, const void* data, size_t size )
+	{
+		std::scoped_lock< std::mutex > lock( mMutex );
+		if ( !mStream.is_open() )
+			return;
+
+		const uint64_t relativeFrame = frame - mStartFrame;
+		const uint64_t typeFlag = type;
+		const uint32_t payloadSize = static_cast< uint32_t >( size );
+
+		mStream.write( reinterpret_cast< const char* >( &relativeFrame ), sizeof( relativeFrame ) );
+		mStream.write( reinterpret_cast< const char* >( &typeFlag ), sizeof( typeFlag ) );
+		mStream.write( reinterpret_cast< const char* >( &payloadSize ), sizeof( payloadSize ) );
+		mStream.write( static_cast< const char* >( data ), payloadSize );
+
+		mRecordedCount++;
+	}
+
+	EventReplayer::EventReplayer( const fs::path& path )
+	{
+		static const bool registeredBuiltIns = ( RegisterBuiltIn( std::make_index_sequence< EventList::All::Size >() ), true );
+		(void)registeredBuiltIns;
+
+		std::ifstream stream( path, std::ios::binary | std::ios::ate );
+		if ( !stream.is_open() )
+		{
+			SLC_CLOG_ERROR( Events, "Failed to open event trace {} for reading", path.string() );
+			return;
+		}
+
+		mData.resize( static_cast< size_t >( stream.tellg() ) );
+		stream.seekg( 0 );
+		if ( !stream.read( reinterpret_cast< char* >( mData.data() ), static_cast< std::streamsize >( mData.size() ) ) )
+		{
+			SLC_CLOG_ERROR( Events, "Failed to read event trace {}", path.string() );
+			mData.clear();
+			return;
+		}
+
+		EventTrace::Header header;
+		if ( mData.size() < sizeof( header ) )
+		{
+			SLC_CLOG_ERROR( Events, "Event trace {} is too short to hold a header", path.string() );
+			return;
+		}
+
+		std::memcpy( &header, mData.data(), sizeof( header ) );
+		if ( header.magic != EventTrace::Magic || header.version != EventTrace::Version )
+		{
+			SLC_CLOG_ERROR( Events, "Unrecognised event trace format in {}", path.string() );
+			mData.clear();
+			return;
+		}
+
+		// Drop the header and find the last recorded frame. Frames before it with no events replay as empty frames.
+		mData.erase( mData.begin(), mData.begin() + sizeof( header ) );
+
+		EventTrace::RecordHeader record;
+		const Byte* payload;
+		while ( ReadRecord( record, payload ) )
+			mFrameCount = record.frame + 1;
+
+		mCursor = 0;
+		mValid = true;
+	}
+
+	bool EventReplayer::ReplayFrame()
+	{
+		if ( !mValid || mFrame >= mFrameCount )
+			return false;
+
+		EventTrace::RecordHeader record;
+		const Byte* payload;
+		while ( true )
+		{
+			const size_t recordStart = mCursor;
+			if ( !ReadRecord( record, payload ) )
+				break;
+
+			// Leave records of later frames for the next call.
+			if ( record.frame > mFrame )
+			{
+				mCursor = recordStart;
+				break;
+			}
+
+			auto it = sReplayFunctions.find( record.type );
+			if ( it == sReplayFunctions.end() || sPayloadSizes[ record.type ] != record.size )
+			{
+				mSkippedCount++;
+				continue;
+			}
+
+			it->second( payload );
+		}
+
+		mFrame++;
+		return true;
+	}
+
+	bool EventReplayer::ReadRecord( EventTrace::RecordHeader& record, const Byte*& payload )
+	{
+		if ( mCursor + EventTrace::RecordHeaderSize > mData.size() )
+			return false;
+
+		const Byte* data = mData.data() + mCursor;
+		std::memcpy( &record.frame, data, sizeof( record.frame ) );
+		std::memcpy( &record.type, data + sizeof( uint64_t ), sizeof( record.type ) );
+		std::memcpy( &record.size, data + 2 * sizeof( uint64_t ), sizeof( record.size ) );
+
+		if ( mCursor + EventTrace::RecordHeaderSize + record.size > mData.size() )
+			return false;
+
+		payload = data + EventTrace::RecordHeaderSize;
+		mCursor += EventTrace::RecordHeaderSize + record.size;
+		return true;
+	}
+} // namespace slc
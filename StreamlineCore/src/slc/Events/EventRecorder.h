@@ -0,0 +1,151 @@
+#pragma once
+
+#include "EventManager.h"
+
+namespace slc {
+
+	/// <summary>
+	/// Binary event trace layout. A header followed by one record per posted event:
+	/// frame (u64), event type flag (u64), payload size (u32), then the raw event bytes.
+	/// Values are written in native byte order, so traces are only portable between machines of the same endianness.
+	/// </summary>
+	namespace EventTrace {
+
+		SCONSTEXPR uint32_t Magic = 0x45434C53; // "SLCE"
+		SCONSTEXPR uint32_t Version = 1;
+
+		struct Header
+		{
+			uint32_t magic = Magic;
+			uint32_t version = Version;
+		};
+
+		struct RecordHeader
+		{
+			uint64_t frame;
+			uint64_t type;
+			uint32_t size;
+		};
+
+		// Record headers are written field by field, without struct padding.
+		SCONSTEXPR size_t RecordHeaderSize = sizeof( uint64_t ) + sizeof( uint64_t ) + sizeof( uint32_t );
+	} // namespace EventTrace
+
+	/// <summary>
+	/// Writes every recordable event passed to EventManager::Post to a binary trace file, tagged with the frame
+	/// it was posted in. Only trivially copyable events are recorded, which includes all of the built-in events.
+	/// Safe to use while events are posted from multiple threads.
+	/// </summary>
+	class EventRecorder
+	{
+	public:
+		EventRecorder( const fs::path& path );
+		~EventRecorder();
+
+		EventRecorder( const EventRecorder& ) = delete;
+		auto operator=( const EventRecorder& ) = delete;
+
+		/// <summary>
+		/// Attach to the EventManager and start recording. Frames in the trace are relative to this call.
+		/// Does nothing if the trace file could not be opened (see IsOpen).
+		/// </summary>
+		void Start();
+		void Stop();
+
+		void Record( uint64_t frame, EventTypeFlag type, const void* data, size_t size );
+
+		bool IsOpen() const
+		{
+			return mStream.is_open();
+		}
+
+		size_t GetRecordedCount() const
+		{
+			std::scoped_lock< std::mutex > lock( mMutex );
+			return mRecordedCount;
+		}
+
+	private:
+		std::ofstream mStream;
+		mutable std::mutex mMutex;
+		uint64_t mStartFrame = 0;
+		size_t mRecordedCount = 0;
+	};
+
+	/// <summary>
+	/// Reads an event trace and posts its events back through EventManager::Post one recorded frame at a time.
+	/// Needs no window or Application, so a headless benchmark can drive real traces through listeners and layers:
+	///
+	///		EventReplayer replayer( "trace.slcev" );
+	///		while ( replayer.ReplayFrame() )
+	///			EventManager::Dispatch();
+	///
+	/// Built-in events are known automatically. Custom events must be registered with Register before replaying.
+	/// A trace that cannot be read or is not in the expected format is reported to the log and leaves IsValid false.
+	/// </summary>
+	class EventReplayer
+	{
+	public:
+		EventReplayer( const fs::path& path );
+
+		template < RecordableEvent T >
+		static void Register()
+		{
+			sReplayFunctions[ T::GetStaticType() ] = []( const Byte* data ) {
+				alignas( T ) Byte storage[ sizeof( T ) ];
+				std::memcpy( storage, data, sizeof( T ) );
+				EventManager::Post< T >( *std::launder( reinterpret_cast< const T* >( storage ) ) );
+			};
+			sPayloadSizes[ T::GetStaticType() ] = sizeof( T );
+		}
+
+		/// <summary>
+		/// Post all events of the next recorded frame. Recorded frames with no events still count, so the
+		/// number of calls matches the number of frames recorded. Returns false once the trace is exhausted.
+		/// </summary>
+		bool ReplayFrame();
+
+		void Restart()
+		{
+			mCursor = 0;
+			mFrame = 0;
+		}
+
+		bool IsValid() const
+		{
+			return mValid;
+		}
+
+		uint64_t GetFrameCount() const
+		{
+			return mFrameCount;
+		}
+
+		size_t GetSkippedCount() const
+		{
+			return mSkippedCount;
+		}
+
+	private:
+		using ReplayFunction = void ( * )( const Byte* data );
+
+		template < size_t... Is >
+		static void RegisterBuiltIn( std::index_sequence< Is... > )
+		{
+			( Register< EventList::All::Type< Is > >(), ... );
+		}
+
+		bool ReadRecord( EventTrace::RecordHeader& record, const Byte*& payload );
+
+	private:
+		std::vector< Byte > mData;
+		size_t mCursor = 0;
+		uint64_t mFrame = 0;
+		uint64_t mFrameCount = 0;
+		size_t mSkippedCount = 0;
+		bool mValid = false;
+
+		inline static std::unordered_map< EventTypeFlag, ReplayFunction > sReplayFunctions;
+		inline static std::unordered_map< EventTypeFlag, size_t > sPayloadSizes;
+	};
+} // namespace slc
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Event.h"
+
+#include "ApplicationEvent.h"
+#include "KeyEvent.h"
+#include "MouseEvent.h"
+
+namespace slc {
+
+	namespace EventList {
+
+		using All = TypeList<
+			WindowCloseEvent,
+			WindowResizeEvent,
+			WindowFocusEvent,
+			WindowFocusLostEvent,
+			WindowMovedEvent,
+
+			AppTickEvent,
+			AppUpdateEvent,
+			AppRenderEvent,
+
+			KeyPressedEvent,
+			KeyReleasedEvent,
+			KeyTypedEvent,
+
+			MouseButtonPressedEvent,
+			MouseButtonReleasedEvent,
+			MouseMovedEvent,
+			MouseScrolledEvent >;
+	}
+
+	using EventTypeSlot = size_t;
+
+	/// <summary>
+	/// Dense index for every event type, used to look up per-type storage with a plain array access.
+	/// Built-in events (EventList::All) map to their position in the list at compile time. Custom events are
+	/// assigned the next free slot the first time they are seen, so their slots follow the built-in ones.
+	/// </summary>
+	class EventTypeIndex
+	{
+	public:
+		SCONSTEXPR EventTypeSlot BuiltInCount = EventList::All::Size;
+
+		template < IsEvent T >
+		static EventTypeSlot Get()
+		{
+			if constexpr ( EventList::All::Contains< T > )
+			{
+				return EventList::All::Index< T >;
+			}
+			else
+			{
+				static const EventTypeSlot slot = sNextSlot.fetch_add( 1, std::memory_order_relaxed );
+				return slot;
+			}
+		}
+
+		/// <summary>
+		/// The number of slots handed out so far, built-in and custom.
+		/// </summary>
+		static EventTypeSlot Count()
+		{
+			return sNextSlot.load( std::memory_order_relaxed );
+		}
+
+	private:
+		inline static std::atomic< EventTypeSlot > sNextSlot = BuiltInCount;
+	};
+} // namespace slc
@@ -9,7 +9,7 @@ namespace slc {
 	public:
 		IEventListener()
 		{
-			EventManager::RegisterListener( this, mType );
+			mHandle = EventManager::RegisterListener( this, mType );
 		}
 		virtual ~IEventListener()
 		{
@@ -26,22 +26,58 @@ namespace slc {
 		bool Accept( Event& event ) const
 		{
 			//   Not already handled		Valid Event Type				Satisfies additional condition
-			return !event.IsHandled() && ( GetListeningEvents() & event.GetType() ) && mAcceptCondition();
+			return !event.IsHandled() && ( GetListeningEvents() & event.GetType() ) && AcceptCondition();
+		}
+
+		ListenerHandle GetHandle() const
+		{
+			return mHandle;
+		}
+
+		bool AcceptCondition() const
+		{
+			return !mAcceptCondition || mAcceptCondition();
+		}
+
+		/// <summary>
+		/// Move this listener into a parallel dispatch group. Listeners in the same group receive events in order on
+		/// one thread, while different groups run concurrently on the EventManager thread pool after the app, ImGui
+		/// and serial listeners. Each group sees events as they were after the app and ImGui listeners, and marking
+		/// an event handled only stops the rest of that group.
+		///
+		/// Only valid for listeners that are thread safe: OnEvent must treat the event as read-only. Destroying a grouped
+		/// listener while its group is calling it waits for that call to return, so two groups must not destroy each
+		/// other's listeners from inside OnEvent. Events posted from any group are dispatched next frame.
+		/// Group SerialDispatchGroup (the default) runs on the main thread.
+		/// </summary>
+		void SetDispatchGroup( uint32_t group )
+		{
+			mDispatchGroup = group;
+			EventManager::InvalidateListeners();
+		}
+
+		uint32_t GetDispatchGroup() const
+		{
+			return mDispatchGroup;
 		}
 
 	private:
 		IEventListener( EventManager::ListenerType type )
 			: mType( type )
 		{
-			EventManager::RegisterListener( this, mType );
+			mHandle = EventManager::RegisterListener( this, mType );
 		}
 
 		friend class Application;
 		friend class ImGuiController;
+		friend class EventManager;
 
 	private:
+		ListenerHandle mHandle;
+		uint32_t mDispatchGroup = EventManager::SerialDispatchGroup;
 		EventManager::ListenerType mType = EventManager::ListenerType::Generic;
-		Predicate<> mAcceptCondition = []() { return true; };
+		// Empty unless a condition is set, so the common case skips the call.
+		Predicate<> mAcceptCondition;
 	};
 
 #define LISTENING_EVENTS( ... )                                                \
@@ -14,6 +14,8 @@ namespace slc {
 			: mouseX( x ), mouseY( y )
 		{}
 
+		SCONSTEXPR EventCoalescing Coalescing = EventCoalescing::KeepLast;
+
 		EVENT_DATA_TYPE( MouseMoved )
 	};
 
@@ -25,6 +27,14 @@ namespace slc {
 			: xOffset( x ), yOffset( y )
 		{}
 
+		SCONSTEXPR EventCoalescing Coalescing = EventCoalescing::SumDeltas;
+
+		void Accumulate( const MouseScrolledEvent& other )
+		{
+			xOffset += other.xOffset;
+			yOffset += other.yOffset;
+		}
+
 		EVENT_DATA_TYPE( MouseScrolled )
 	};
 
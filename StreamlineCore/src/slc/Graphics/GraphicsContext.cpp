@@ -23,10 +23,10 @@ namespace slc {
 		const char* renderer = ( char* )glGetString( GL_RENDERER );
 		const char* version = ( char* )glGetString( GL_VERSION );
 
-		Log::Info( "OpenGL Info:" );
-		Log::Info( "  Vendor: {0}", vendor );
-		Log::Info( "  Renderer: {0}", renderer );
-		Log::Info( "  Version: {0}", version );
+		SLC_CLOG_INFO( Graphics, "OpenGL Info:" );
+		SLC_CLOG_INFO( Graphics, "  Vendor: {0}", vendor );
+		SLC_CLOG_INFO( Graphics, "  Renderer: {0}", renderer );
+		SLC_CLOG_INFO( Graphics, "  Version: {0}", version );
 
 		ASSERT( GLVersion.major > 4 || ( GLVersion.major == 4 && GLVersion.minor >= 5 ), "Labyrinth requires at least OpenGL version 4.5!" );
 	}
@@ -21,16 +21,16 @@ namespace slc {
 		switch ( severity )
 		{
 			case GL_DEBUG_SEVERITY_HIGH:
-				Log::Error( message );
+				SLC_CLOG_ERROR( Graphics, message );
 				return;
 			case GL_DEBUG_SEVERITY_MEDIUM:
-				Log::Warn( message );
+				SLC_CLOG_WARN( Graphics, message );
 				return;
 			case GL_DEBUG_SEVERITY_LOW:
-				Log::Info( message );
+				SLC_CLOG_INFO( Graphics, message );
 				return;
 			case GL_DEBUG_SEVERITY_NOTIFICATION:
-				Log::Trace( message );
+				SLC_CLOG_TRACE( Graphics, message );
 				return;
 		}
 
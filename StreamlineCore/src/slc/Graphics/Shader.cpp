@@ -108,7 +108,7 @@ namespace slc {
 			CompileOrGetVulkanBinaries( shaderSources );
 			CompileOrGetOpenGLBinaries();
 			CreateProgram();
-			Log::Info( "Shader creation took {0} ms", timer.ElapsedMillis() );
+			SLC_CLOG_INFO( Graphics, "Shader creation took {0} ms", timer.ElapsedMillis() );
 		}
 
 		// Extract name from file path
@@ -195,7 +195,7 @@ namespace slc {
 				shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv( source, Utils::GLShaderStageToShaderC( stage ), mFilepath.c_str(), options );
 				if ( module.GetCompilationStatus() != shaderc_compilation_status_success )
 				{
-					Log::Error( module.GetErrorMessage() );
+					SLC_CLOG_ERROR( Graphics, module.GetErrorMessage() );
 					ASSERT( false );
 				}
 
@@ -256,7 +256,7 @@ namespace slc {
 				shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv( source, Utils::GLShaderStageToShaderC( stage ), mFilepath.c_str() );
 				if ( module.GetCompilationStatus() != shaderc_compilation_status_success )
 				{
-					Log::Error( module.GetErrorMessage() );
+					SLC_CLOG_ERROR( Graphics, module.GetErrorMessage() );
 					ASSERT( false );
 				}
 
@@ -298,7 +298,7 @@ namespace slc {
 
 			std::vector< GLchar > infoLog( maxLength );
 			glGetProgramInfoLog( program, maxLength, &maxLength, infoLog.data() );
-			Log::Error( "Shader linking failed ({0}):\n{1}", mFilepath, infoLog.data() );
+			SLC_CLOG_ERROR( Graphics, "Shader linking failed ({0}):\n{1}", mFilepath, infoLog.data() );
 
 			glDeleteProgram( program );
 
@@ -320,11 +320,11 @@ namespace slc {
 		// spirv_cross::Compiler compiler(shaderData);
 		// spirv_cross::ShaderResources resources = compiler.get_shader_resources();
 
-		// Log::Trace("Shader::Reflect - {0} {1}", Utils::GLShaderStageToString(stage), mFilepath);
-		// Log::Trace("    {0} uniform buffers", resources.uniform_buffers.size());
-		// Log::Trace("    {0} resources", resources.sampled_images.size());
+		// SLC_CLOG_TRACE(Graphics, "Shader::Reflect - {0} {1}", Utils::GLShaderStageToString(stage), mFilepath);
+		// SLC_CLOG_TRACE(Graphics, "    {0} uniform buffers", resources.uniform_buffers.size());
+		// SLC_CLOG_TRACE(Graphics, "    {0} resources", resources.sampled_images.size());
 
-		// Log::Trace("Uniform buffers:");
+		// SLC_CLOG_TRACE(Graphics, "Uniform buffers:");
 		// for (const auto& resource : resources.uniform_buffers)
 		//{
 		//	const auto& bufferType = compiler.get_type(resource.base_type_id);
@@ -332,10 +332,10 @@ namespace slc {
 		//	uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
 		//	size_t memberCount = bufferType.member_types.size();
 
-		//	Log::Trace("  {0}", resource.name);
-		//	Log::Trace("    Size = {0}", bufferSize);
-		//	Log::Trace("    Binding = {0}", binding);
-		//	Log::Trace("    Members = {0}", memberCount);
+		//	SLC_CLOG_TRACE(Graphics, "  {0}", resource.name);
+		//	SLC_CLOG_TRACE(Graphics, "    Size = {0}", bufferSize);
+		//	SLC_CLOG_TRACE(Graphics, "    Binding = {0}", binding);
+		//	SLC_CLOG_TRACE(Graphics, "    Members = {0}", memberCount);
 		//}
 	}
 
@@ -409,7 +409,7 @@ namespace slc {
 		if ( location == -1 )
 		{
 			// Don't store in cache if unable to find uniform.
-			Log::Warn( "Could not get uniform `{0}` from shader to add to cache!", name );
+			SLC_CLOG_WARN( Graphics, "Could not get uniform `{0}` from shader to add to cache!", name );
 			return location;
 		}
 
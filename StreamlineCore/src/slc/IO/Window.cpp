@@ -12,7 +12,7 @@ namespace slc {
 
 	static void GLFWErrorCallback(int error, const char* description)
 	{
-		Log::Error("GLFW Error ({0}): {1}", error, description);
+		SLC_CLOG_ERROR(IO, "GLFW Error ({0}): {1}", error, description);
 	}
 
 	Unique<Window> Window::Create(const WindowProperties& props)
@@ -79,7 +79,7 @@ namespace slc {
 			glfwWindowHint(GLFW_DECORATED, GLFW_FALSE);
 		}
 
-		Log::Trace("Creating window {0} ({1}, {2})", mData.title, mData.width, mData.height);
+		SLC_CLOG_TRACE(IO, "Creating window {0} ({1}, {2})", mData.title, mData.width, mData.height);
 
 		{
 #if defined(_DEBUG)
@@ -94,10 +94,10 @@ namespace slc {
 		int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 		ASSERT(status, "Failed to initialize Glad!");
 
-		Log::Info("OpenGL Info:");
-		Log::Info("  Vendor: {0}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
-		Log::Info("  Renderer: {0}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
-		Log::Info("  Version: {0}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+		SLC_CLOG_INFO(Graphics, "OpenGL Info:");
+		SLC_CLOG_INFO(Graphics, "  Vendor: {0}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+		SLC_CLOG_INFO(Graphics, "  Renderer: {0}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+		SLC_CLOG_INFO(Graphics, "  Version: {0}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
 
 		ASSERT(GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 5), "Streamline requires at least OpenGL version 4.5!");
 
@@ -195,6 +195,6 @@ namespace slc {
 		{
 			glfwTerminate();
 		}
-		Log::Info("Shutdown complete");
+		SLC_CLOG_INFO(IO, "Shutdown complete");
 	}
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 
+#include "slc/Common/Macros.h"
+
+#include <cstdint>
 #include <span>
+#include <string>
+#include <utility>
 
 namespace slc {
 
@@ -14,12 +19,52 @@ namespace slc {
 		Fatal
 	};
 
+	/// <summary>
+	/// Source of a log message, filtered by a bitmask both at compile time (SLC_LOG_CATEGORY_MASK) and at
+	/// runtime (Logger::SetCategoryEnabled). Applications can use bits User to 63 for their own categories.
+	/// </summary>
+	enum class LogCategory : uint8_t
+	{
+		General,
+		Allocators,
+		Coroutine,
+		Events,
+		Graphics,
+		ImGui,
+		IO,
+		Reflection,
+		Threading,
+
+		User = 32
+	};
+
+	SASSERT( std::to_underlying( LogCategory::User ) < 64, "Log categories must fit in a 64 bit mask" );
+
+	constexpr uint64_t LogCategoryBit( LogCategory category )
+	{
+		ASSERT( std::to_underlying( category ) < 64, "Log category is outside the 64 bit mask" );
+		return uint64_t( 1 ) << std::to_underlying( category );
+	}
+
 	using MessageBuffer = std::span< char >;
 
+	/// <summary>
+	/// Formats a message whose arguments were copied into the log ring unformatted, appending the result to out.
+	/// </summary>
+	using DeferredFormatFunction = void ( * )( const char* payload, LogLevel level, std::string& out );
+
+	/// <summary>
+	/// Arguments that can be copied into the log ring and formatted later on the worker thread. Limited to plain
+	/// values: strings and pointers could be dangling by the time the worker gets to them.
+	/// </summary>
+	template < typename T >
+	concept DeferrableLogArgument = std::is_arithmetic_v< std::remove_cvref_t< T > > or std::is_enum_v< std::remove_cvref_t< T > >;
+
 	struct MessageEntry
 	{
 		MessageBuffer message;
 		std::size_t length;
 		LogLevel level;
+		uint64_t sequence;
 	};
 } // namespace slc
\ No newline at end of file
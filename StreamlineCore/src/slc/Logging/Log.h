@@ -2,8 +2,33 @@
 
 #include "Logger.h"
 
+/*
+ *	Compile time filtering
+ *
+ *	SLC_LOG_MIN_LEVEL: messages below this level are compiled out. Uses the LogLevel values, 0 (Trace) to 5 (Fatal).
+ *	SLC_LOG_CATEGORY_MASK: one bit per LogCategory. Categories whose bit is clear are compiled out.
+ */
+
+#ifndef SLC_LOG_MIN_LEVEL
+#define SLC_LOG_MIN_LEVEL 0
+#endif
+
+#ifndef SLC_LOG_CATEGORY_MASK
+#define SLC_LOG_CATEGORY_MASK 0xFFFFFFFFFFFFFFFFull
+#endif
+
 namespace slc::Log {
 
+	SCONSTEXPR LogLevel CompiledMinLevel = static_cast< LogLevel >( SLC_LOG_MIN_LEVEL );
+	SCONSTEXPR uint64_t CompiledCategoryMask = SLC_LOG_CATEGORY_MASK;
+
+	SASSERT( SLC_LOG_MIN_LEVEL >= std::to_underlying( LogLevel::Trace ) and SLC_LOG_MIN_LEVEL <= std::to_underlying( LogLevel::Fatal ) + 1 );
+
+	SCONSTEXPR bool IsCompiledIn( LogLevel level, LogCategory category = LogCategory::General )
+	{
+		return std::to_underlying( level ) >= std::to_underlying( CompiledMinLevel ) and ( CompiledCategoryMask & LogCategoryBit( category ) ) != 0;
+	}
+
 	/*
 	 *   Utility Functions
 	 */
@@ -14,86 +39,172 @@ namespace slc::Log {
 		logger.SetLogLevel( level );
 	}
 
+	inline void SetCategoryEnabled( LogCategory category, bool enabled )
+	{
+		auto& logger = Logger::GetGlobalLogger();
+		logger.SetCategoryEnabled( category, enabled );
+	}
+
+	inline bool IsEnabled( LogLevel level, LogCategory category = LogCategory::General )
+	{
+		return IsCompiledIn( level, category ) and Logger::GetGlobalLogger().IsEnabled( level, category );
+	}
+
 
 	/*
 	 *	Logging Functions
+	 *
+	 *	Levels below SLC_LOG_MIN_LEVEL compile to empty functions, but the arguments are still evaluated at the
+	 *	call site. Use the SLC_LOG_* macros below where that matters.
 	 */
 
 	inline void Trace( std::string_view message )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Trace, message );
+		if constexpr ( IsCompiledIn( LogLevel::Trace ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Trace, message );
+		}
 	}
 
 	template < typename... Args >
 	void Trace( std::format_string< Args... > message, Args&&... args )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Trace, message, std::forward< Args >( args )... );
+		if constexpr ( IsCompiledIn( LogLevel::Trace ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Trace, message, std::forward< Args >( args )... );
+		}
 	}
 
 	inline void Debug( std::string_view message )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Debug, message );
+		if constexpr ( IsCompiledIn( LogLevel::Debug ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Debug, message );
+		}
 	}
 
 	template < typename... Args >
 	void Debug( std::format_string< Args... > message, Args&&... args )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Debug, message, std::forward< Args >( args )... );
+		if constexpr ( IsCompiledIn( LogLevel::Debug ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Debug, message, std::forward< Args >( args )... );
+		}
 	}
 
 	inline void Info( std::string_view message )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Info, message );
+		if constexpr ( IsCompiledIn( LogLevel::Info ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Info, message );
+		}
 	}
 
 	template < typename... Args >
 	void Info( std::format_string< Args... > message, Args&&... args )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Info, message, std::forward< Args >( args )... );
+		if constexpr ( IsCompiledIn( LogLevel::Info ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Info, message, std::forward< Args >( args )... );
+		}
 	}
 
 	inline void Warn( std::string_view message )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Warning, message );
+		if constexpr ( IsCompiledIn( LogLevel::Warning ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Warning, message );
+		}
 	}
 
 	template < typename... Args >
 	static void Warn( std::format_string< Args... > message, Args&&... args )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Warning, message, std::forward< Args >( args )... );
+		if constexpr ( IsCompiledIn( LogLevel::Warning ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Warning, message, std::forward< Args >( args )... );
+		}
 	}
 
 	inline void Error( std::string_view message )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Error, message );
+		if constexpr ( IsCompiledIn( LogLevel::Error ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Error, message );
+		}
 	}
 
 	template < typename... Args >
 	static void Error( std::format_string< Args... > message, Args&&... args )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Error, message, std::forward< Args >( args )... );
+		if constexpr ( IsCompiledIn( LogLevel::Error ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Error, message, std::forward< Args >( args )... );
+		}
 	}
 
 	inline void Fatal( std::string_view message )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Fatal, message );
+		if constexpr ( IsCompiledIn( LogLevel::Fatal ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Fatal, message );
+		}
 	}
 
 	template < typename... Args >
 	static void Fatal( std::format_string< Args... > message, Args&&... args )
 	{
-		auto& logger = Logger::GetGlobalLogger();
-		logger.Log( LogLevel::Fatal, message, std::forward< Args >( args )... );
+		if constexpr ( IsCompiledIn( LogLevel::Fatal ) )
+		{
+			auto& logger = Logger::GetGlobalLogger();
+			logger.Log( LogLevel::Fatal, message, std::forward< Args >( args )... );
+		}
 	}
-} // namespace slc::Log
\ No newline at end of file
+} // namespace slc::Log
+
+/*
+ *	Logging Macros
+ *
+ *	Statements filtered out at compile time are discarded entirely. Otherwise the runtime level and category
+ *	mask are checked first, so arguments are only evaluated for messages that will be written.
+ *
+ *		SLC_CLOG_DEBUG( Graphics, "Uploaded {} bytes", CountBytes() );
+ *
+ *	The SLC_CLOG_* macros take a LogCategory name. Use SLC_LOG directly for categories above LogCategory::User.
+ */
+
+#define SLC_LOG( level, category, ... )                                         \
+	do                                                                          \
+	{                                                                           \
+		if constexpr ( ::slc::Log::IsCompiledIn( level, category ) )            \
+		{                                                                       \
+			auto& slc_logger_ = ::slc::Logger::GetGlobalLogger();               \
+			if ( slc_logger_.IsEnabled( level, category ) )                     \
+				slc_logger_.Log( level, __VA_ARGS__ );                          \
+		}                                                                       \
+	} while ( false )
+
+#define SLC_LOG_TRACE( ... ) SLC_LOG( ::slc::LogLevel::Trace, ::slc::LogCategory::General, __VA_ARGS__ )
+#define SLC_LOG_DEBUG( ... ) SLC_LOG( ::slc::LogLevel::Debug, ::slc::LogCategory::General, __VA_ARGS__ )
+#define SLC_LOG_INFO( ... )  SLC_LOG( ::slc::LogLevel::Info, ::slc::LogCategory::General, __VA_ARGS__ )
+#define SLC_LOG_WARN( ... )  SLC_LOG( ::slc::LogLevel::Warning, ::slc::LogCategory::General, __VA_ARGS__ )
+#define SLC_LOG_ERROR( ... ) SLC_LOG( ::slc::LogLevel::Error, ::slc::LogCategory::General, __VA_ARGS__ )
+#define SLC_LOG_FATAL( ... ) SLC_LOG( ::slc::LogLevel::Fatal, ::slc::LogCategory::General, __VA_ARGS__ )
+
+#define SLC_CLOG_TRACE( category, ... ) SLC_LOG( ::slc::LogLevel::Trace, ::slc::LogCategory::category, __VA_ARGS__ )
+#define SLC_CLOG_DEBUG( category, ... ) SLC_LOG( ::slc::LogLevel::Debug, ::slc::LogCategory::category, __VA_ARGS__ )
+#define SLC_CLOG_INFO( category, ... )  SLC_LOG( ::slc::LogLevel::Info, ::slc::LogCategory::category, __VA_ARGS__ )
+#define SLC_CLOG_WARN( category, ... )  SLC_LOG( ::slc::LogLevel::Warning, ::slc::LogCategory::category, __VA_ARGS__ )
+#define SLC_CLOG_ERROR( category, ... ) SLC_LOG( ::slc::LogLevel::Error, ::slc::LogCategory::category, __VA_ARGS__ )
+#define SLC_CLOG_FATAL( category, ... ) SLC_LOG( ::slc::LogLevel::Fatal, ::slc::LogCategory::category, __VA_ARGS__ )
\ No newline at end of file
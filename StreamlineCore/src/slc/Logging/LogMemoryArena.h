@@ -14,6 +14,11 @@ namespace slc {
 		std::optional< MessageBuffer > RequestBuffer( std::size_t size );
 		void ReleaseBuffers();
 
+		std::size_t Capacity() const
+		{
+			return mCapacity;
+		}
+
 	private:
 		Unique< char[] > mBuffer;
 		std::size_t mCapacity;
@@ -0,0 +1,34 @@
+#include "LogRing.h"
+
+#include "slc/Common/Profiling.h"
+
+#include <bit>
+
+namespace slc {
+
+	LogRing::LogRing( std::size_t capacity )
+		: mCapacity{ std::bit_ceil( std::max( capacity, 4 * HeaderSize ) ) }
+		, mMask{ mCapacity - 1 }
+		, mBuffer{ MakeUnique< char[] >( mCapacity ) }
+	{
+	}
+
+	void LogRing::WaitForSpace( std::size_t size )
+	{
+		SLC_PROFILE_FUNCTION();
+
+		size = std::min( size, MaxMessageSize() );
+
+		const uint64_t head = mHead.load( std::memory_order_relaxed );
+		const uint64_t end = RecordPosition( head, HeaderSize + Align( size ) ) + HeaderSize + Align( size );
+
+		uint64_t tail = mTail.load( std::memory_order_acquire );
+		while ( end - tail > mCapacity )
+		{
+			mTail.wait( tail, std::memory_order_acquire );
+			tail = mTail.load( std::memory_order_acquire );
+		}
+
+		mCachedTail = tail;
+	}
+} // namespace slc
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "slc/Common/Base.h"
+
+#include "Common.h"
+
+namespace slc {
+
+	struct LogRecord
+	{
+		uint64_t sequence;
+		std::size_t length;
+		LogLevel level;
+		// Set when the record holds unformatted arguments rather than text.
+		DeferredFormatFunction format = nullptr;
+	};
+
+	/// <summary>
+	/// Single producer, single consumer byte ring of variable length log records. Every logging thread writes
+	/// into its own ring, so the producer side needs no lock: space for a message is reserved at the head, the
+	/// message is formatted straight into it, and publishing commits only the bytes actually used with one
+	/// release store. The logger worker is the only consumer.
+	///
+	/// A ring belongs to at most one thread at a time. When its thread exits the ring is released and may be
+	/// claimed by a new thread; anything still in it is drained as normal.
+	/// </summary>
+	class LogRing final : public RefCounted
+	{
+	public:
+		SCONSTEXPR std::size_t CacheLineSize = 64;
+
+		// Records start on this alignment so deferred argument payloads can be constructed in place.
+		SCONSTEXPR std::size_t RecordAlignment = 16;
+		SCONSTEXPR std::size_t HeaderSize = ( sizeof( LogRecord ) + RecordAlignment - 1 ) & ~( RecordAlignment - 1 );
+
+		SASSERT( __STDCPP_DEFAULT_NEW_ALIGNMENT__ >= RecordAlignment );
+
+		LogRing( std::size_t capacity );
+
+		LogRing( const LogRing& ) = delete;
+		auto operator=( const LogRing& ) = delete;
+
+		bool TryClaim()
+		{
+			return not mOwned.test_and_set( std::memory_order_acquire );
+		}
+		void Release()
+		{
+			mOwned.clear( std::memory_order_release );
+		}
+
+		/// <summary>
+		/// Largest message a single record can hold.
+		/// </summary>
+		std::size_t MaxMessageSize() const
+		{
+			return mCapacity / 2 - HeaderSize;
+		}
+
+		/// <summary>
+		/// Producer only. Reserve space for a message of up to size bytes, or an empty buffer if the ring is
+		/// too full. Nothing is committed until Publish, so reserving again replaces the previous reservation.
+		/// </summary>
+		MessageBuffer Acquire( std::size_t size )
+		{
+			size = std::min( size, MaxMessageSize() );
+
+			const uint64_t head = mHead.load( std::memory_order_relaxed );
+			const uint64_t position = RecordPosition( head, HeaderSize + Align( size ) );
+			const uint64_t end = position + HeaderSize + Align( size );
+
+			if ( end - mCachedTail > mCapacity )
+			{
+				mCachedTail = mTail.load( std::memory_order_acquire );
+				if ( end - mCachedTail > mCapacity )
+					return {};
+			}
+
+			// Records never straddle the end of the buffer. Mark the skipped tail so the consumer jumps it too.
+			if ( position != head and mCapacity - ( head & mMask ) >= HeaderSize )
+			{
+				LogRecord wrap{ 0, WrapMarker, LogLevel::Trace };
+				std::memcpy( mBuffer.get() + ( head & mMask ), &wrap, sizeof( LogRecord ) );
+			}
+
+			mReserved = position;
+			return { mBuffer.get() + ( position & mMask ) + HeaderSize, size };
+		}
+
+		/// <summary>
+		/// Producer only. Commit record.length bytes of the last reservation and hand them to the consumer.
+		/// Returns the number of ring bytes the record used, including any padding.
+		/// </summary>
+		std::size_t Publish( const LogRecord& record )
+		{
+			const uint64_t head = mHead.load( std::memory_order_relaxed );
+			std::memcpy( mBuffer.get() + ( mReserved & mMask ), &record, sizeof( LogRecord ) );
+
+			const uint64_t end = mReserved + HeaderSize + Align( record.length );
+			mHead.store( end, std::memory_order_release );
+
+			return static_cast< std::size_t >( end - head );
+		}
+
+		/// <summary>
+		/// Producer only. Block until the consumer has freed enough space for a message of size bytes.
+		/// </summary>
+		void WaitForSpace( std::size_t size );
+
+		/// <summary>
+		/// Consumer only. Calls func( record, message ) for every published record, then frees their space.
+		/// Returns the number of ring bytes freed.
+		/// </summary>
+		template < typename Func >
+		std::size_t Drain( Func&& func )
+		{
+			const uint64_t tail = mTail.load( std::memory_order_relaxed );
+			const uint64_t head = mHead.load( std::memory_order_acquire );
+			if ( head == tail )
+				return 0;
+
+			uint64_t position = tail;
+			while ( position != head )
+			{
+				const std::size_t offset = position & mMask;
+				if ( mCapacity - offset < HeaderSize )
+				{
+					position += mCapacity - offset;
+					continue;
+				}
+
+				LogRecord record;
+				std::memcpy( &record, mBuffer.get() + offset, sizeof( LogRecord ) );
+				if ( record.length == WrapMarker )
+				{
+					position += mCapacity - offset;
+					continue;
+				}
+
+				func( record, std::span< const char >( mBuffer.get() + offset + HeaderSize, record.length ) );
+				position += HeaderSize + Align( record.length );
+			}
+
+			mTail.store( head, std::memory_order_release );
+			mTail.notify_all();
+
+			return static_cast< std::size_t >( head - tail );
+		}
+
+		bool Empty() const
+		{
+			return mHead.load( std::memory_order_acquire ) == mTail.load( std::memory_order_acquire );
+		}
+
+	private:
+		SCONSTEXPR std::size_t WrapMarker = Limits< std::size_t >::Max;
+
+		SCONSTEXPR std::size_t Align( std::size_t size )
+		{
+			return ( size + RecordAlignment - 1 ) & ~( RecordAlignment - 1 );
+		}
+
+		// Records that would run past the end of the buffer start again at the beginning instead.
+		uint64_t RecordPosition( uint64_t head, std::size_t recordSize ) const
+		{
+			const std::size_t remaining = mCapacity - ( head & mMask );
+			return remaining < recordSize ? head + remaining : head;
+		}
+
+	private:
+		// Producer and consumer indices on separate cache lines so the two threads never share one.
+		alignas( CacheLineSize ) std::atomic_uint64_t mHead = 0;
+		uint64_t mCachedTail = 0;
+		uint64_t mReserved = 0;
+
+		alignas( CacheLineSize ) std::atomic_uint64_t mTail = 0;
+
+		alignas( CacheLineSize ) std::atomic_flag mOwned;
+
+		std::size_t mCapacity;
+		uint64_t mMask;
+
+		Unique< char[] > mBuffer;
+	};
+} // namespace slc
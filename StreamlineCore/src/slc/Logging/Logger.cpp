@@ -7,6 +7,33 @@
 
 namespace {
 
+	struct ThreadRingEntry
+	{
+		uint64_t logger_id;
+		slc::Ref< slc::LogRing > ring;
+	};
+
+	constinit thread_local bool tThreadRingsReleased = false;
+
+	// Rings this thread produces into, one per logger. Released on thread exit so another thread can take them over.
+	struct ThreadRings
+	{
+		std::vector< ThreadRingEntry > entries;
+
+		~ThreadRings()
+		{
+			for ( auto& entry : entries )
+				entry.ring->Release();
+
+			entries.clear();
+			tThreadRingsReleased = true;
+		}
+	};
+
+	constinit thread_local ThreadRings tThreadRings;
+
+	constinit std::atomic_uint64_t sNextLoggerId = 0;
+
 	static slc::Logger& MakeErrorLogger()
 	{
 		static slc::Logger logger;
@@ -34,106 +61,329 @@ namespace slc {
 		: mMinLogLevel( LogLevel::Debug )
 		, mTerminate( false )
 		, mLastFlush{ Clock::now() }
+		, mId( sNextLoggerId.fetch_add( 1, std::memory_order_relaxed ) )
 		, mMessageSizeLimit( message_size_limit )
 		, mMaxMessagesBeforeFlush( max_messages_before_flush )
-		, mArena( message_size_limit * max_messages_before_flush )
+		, mRingCapacity( std::max( RingCapacity, 4 * ( message_size_limit + LogRing::HeaderSize ) ) )
+		, mFlushThreshold( std::min( message_size_limit * max_messages_before_flush, mRingCapacity ) / 2 )
+		, mLastWrite{ Clock::now() }
 	{
+		for ( std::size_t i = 0; i < WriteBufferCount; i++ )
+		{
+			auto& buffer = mWriteBuffers.emplace_back( MakeUnique< WriteBuffer >( message_size_limit * max_messages_before_flush ) );
+			buffer->queue.reserve( mMaxMessagesBeforeFlush );
+			mFreeBuffers.push_back( buffer.get() );
+		}
+
+		mCurrentBuffer = mFreeBuffers.back();
+		mFreeBuffers.pop_back();
+
+		mWriter = std::thread( &Logger::WriteBuffers, this );
 		mWorker = std::thread( &Logger::ProcessQueue, this );
-		mMessageBuffer.reserve( mMessageSizeLimit * mMaxMessagesBeforeFlush );
 	}
 
 	Logger::~Logger()
 	{
 		{
-			std::unique_lock< std::mutex > lock( mQueueMutex );
+			std::unique_lock< std::mutex > lock( mWorkerMutex );
 			mTerminate = true;
 		}
 		mCV.notify_all();
 		mWorker.join();
+		mWriter.join();
+	}
+
+	Logger::LoggerStats Logger::GetStats() const
+	{
+		LoggerStats stats;
+		stats.total_flushes = mStats.total_flushes.load( std::memory_order_relaxed );
+		stats.messages_since_last_flush = mStats.messages_since_last_flush.load( std::memory_order_relaxed );
+		stats.time_since_last_flush = mStats.time_since_last_flush.load( std::memory_order_relaxed );
+		stats.large_message_count = mStats.large_message_count.load( std::memory_order_relaxed );
+		stats.ring_full_waits = mStats.ring_full_waits.load( std::memory_order_relaxed );
+		stats.write_buffer_full_waits = mStats.write_buffer_full_waits.load( std::memory_order_relaxed );
+
+		std::scoped_lock< std::mutex > lock( mRingsMutex );
+		stats.thread_rings = mRings.size();
+		return stats;
 	}
 
 	void Logger::SetLogLevel( LogLevel level )
 	{
-		mMinLogLevel = level;
+		mMinLogLevel.store( level, std::memory_order_relaxed );
 	}
 
 	void Logger::Log( LogLevel level, std::string_view message )
 	{
 		SLC_PROFILE_FUNCTION();
 
-		if ( std::to_underlying( level ) < std::to_underlying( mMinLogLevel ) )
+		if ( std::to_underlying( level ) < std::to_underlying( mMinLogLevel.load( std::memory_order_relaxed ) ) )
+			return;
+
+		LogRing* ring = GetThreadRing();
+		if ( not ring ) [[unlikely]]
 			return;
 
-		std::optional< MessageBuffer > buffer = mArena.RequestBuffer( mMessageSizeLimit );
-		if ( not buffer.has_value() )
+		MessageBuffer buffer = ring->Acquire( mMessageSizeLimit );
+		if ( buffer.empty() ) [[unlikely]]
+			buffer = WaitForRingSpace( *ring, mMessageSizeLimit );
+
+		auto level_string = Enum::ToString( level );
+		const char* timestamp = UpdateCurrentTimestamp();
+
+		std::size_t formatted_size{};
 		{
-			{
-				SLC_PROFILE_SCOPE( "Logging - Notify" );
+			SLC_PROFILE_SCOPE( "Logging - Format message" );
 
-				mCV.notify_one();
-			}
-			{
-				SLC_PROFILE_SCOPE( "Logging - Wait" );
+			auto prefix_result = std::format_to_n( buffer.data(), buffer.size(), "[{}] {}: ", level_string, timestamp );
+			auto prefix_size = std::min( static_cast< std::size_t >( prefix_result.size ), buffer.size() );
+			formatted_size = prefix_size + message.size();
 
-				std::unique_lock< std::mutex > lock( mQueueMutex );
-				mCV.wait( lock, [ this ] { return mMessageQueue.size() < mMaxMessagesBeforeFlush; } );
-			}
+			if ( formatted_size <= buffer.size() )
+				std::memcpy( buffer.data() + prefix_size, message.data(), message.size() );
+		}
 
-			{
-				SLC_PROFILE_SCOPE( "Logging - Get Buffer Retry" );
+		if ( formatted_size > buffer.size() ) [[unlikely]]
+		{
+			std::string& scratch = GetScratchBuffer();
+			scratch.clear();
+			std::format_to( std::back_inserter( scratch ), "[{}] {}: ", level_string, timestamp );
+			scratch.append( message );
 
-				buffer = mArena.RequestBuffer( mMessageSizeLimit );
-				ASSERT( buffer.has_value(), "Still could not create message buffer despite flush" );
-			}
+			PublishLargeMessage( *ring, scratch, level );
+			return;
 		}
 
-		auto level_string = Enum::ToString( level );
+		PublishMessage( *ring, formatted_size, level );
+	}
+
+	LogRing* Logger::GetThreadRing()
+	{
+		for ( auto& entry : tThreadRings.entries )
+		{
+			if ( entry.logger_id == mId )
+				return entry.ring.Data();
+		}
 
-		UpdateCurrentTimestamp();
+		return ClaimThreadRing();
+	}
 
-		std::size_t formatted_size{};
+	LogRing* Logger::ClaimThreadRing()
+	{
+		SLC_PROFILE_FUNCTION();
+
+		// Messages logged by thread_local destructors that run after this thread's rings were released are dropped.
+		if ( tThreadRingsReleased )
+			return nullptr;
+
+		Ref< LogRing > ring;
 		{
-			SLC_PROFILE_SCOPE( "Logging - Format message" );
+			std::scoped_lock< std::mutex > lock( mRingsMutex );
 
-			auto format_result = std::format_to_n( buffer->begin(), mMessageSizeLimit, "[{}] {}: {}", level_string, mTimestampCache.format_string.data(), message.data() );
-			formatted_size = std::min( static_cast< std::size_t >( format_result.size ), mMessageSizeLimit );
+			// Reuse a ring left behind by a thread that has exited before creating a new one.
+			auto it = std::ranges::find_if( mRings, []( Ref< LogRing >& candidate ) { return candidate->TryClaim(); } );
+			if ( it != mRings.end() )
+			{
+				ring = *it;
+			}
+			else
+			{
+				ring = Ref< LogRing >::Create( mRingCapacity );
+				ring->TryClaim();
+				mRings.push_back( ring );
+			}
 		}
 
-		if ( formatted_size == mMessageSizeLimit )
-			mStats.large_message_count++;
+		tThreadRings.entries.push_back( { mId, ring } );
+		return ring.Data();
+	}
+
+	MessageBuffer Logger::WaitForRingSpace( LogRing& ring, std::size_t size )
+	{
+		SLC_PROFILE_FUNCTION();
 
+		mStats.ring_full_waits.fetch_add( 1, std::memory_order_relaxed );
+
+		MessageBuffer buffer;
+		while ( ( buffer = ring.Acquire( size ) ).empty() )
 		{
-			SLC_PROFILE_SCOPE( "Logging - Lock queue and push" );
+			// Slow path only, so taking the lock here is fine and guarantees the worker sees the request.
+			{
+				std::lock_guard< std::mutex > lock( mWorkerMutex );
+				mFlushRequested = true;
+			}
+			mCV.notify_one();
 
-			std::lock_guard< std::mutex > lock( mQueueMutex );
-			mMessageQueue.emplace_back( *buffer, formatted_size, level );
+			ring.WaitForSpace( size );
 		}
 
-		mStats.messages_since_last_flush++;
+		return buffer;
+	}
+
+	void Logger::PublishMessage( LogRing& ring, std::size_t formatted_size, LogLevel level, DeferredFormatFunction format )
+	{
+		const std::size_t bytes = ring.Publish( { mSequence.fetch_add( 1, std::memory_order_relaxed ), formatted_size, level, format } );
+		mStats.messages_since_last_flush.fetch_add( 1, std::memory_order_relaxed );
+
+		// Only the message that crosses the threshold wakes the worker. Without the lock the notification can
+		// be missed, in which case the worker picks the messages up on its next timed wake.
+		const std::size_t pending = mPendingBytes.fetch_add( bytes, std::memory_order_relaxed );
+		if ( pending < mFlushThreshold and pending + bytes >= mFlushThreshold )
+			mCV.notify_one();
+	}
+
+	void Logger::PublishLargeMessage( LogRing& ring, std::string_view message, LogLevel level )
+	{
+		SLC_PROFILE_FUNCTION();
+
+		mStats.large_message_count.fetch_add( 1, std::memory_order_relaxed );
+
+		MessageBuffer buffer = ring.Acquire( message.size() );
+		if ( buffer.empty() )
+			buffer = WaitForRingSpace( ring, message.size() );
 
-		mCV.notify_one();
+		// Only truncated if the message is larger than half the ring.
+		const std::size_t length = std::min( message.size(), buffer.size() );
+		std::memcpy( buffer.data(), message.data(), length );
+		PublishMessage( ring, length, level );
+	}
+
+	std::string& Logger::GetScratchBuffer()
+	{
+		thread_local std::string tScratch;
+		return tScratch;
 	}
 
 	void Logger::ProcessQueue()
 	{
 		while ( true )
 		{
+			bool terminate = false;
 			{
-				std::unique_lock< std::mutex > lock( mQueueMutex );
+				std::unique_lock< std::mutex > lock( mWorkerMutex );
 				mCV.wait_until( lock, mLastFlush + MaxTimeBetweenFlush, [ this ] {
-					return mMessageQueue.size() >= mMaxMessagesBeforeFlush or mTerminate;
+					return mPendingBytes.load( std::memory_order_relaxed ) >= mFlushThreshold or mFlushRequested or mTerminate;
 				} );
 
-				Flush();
+				mFlushRequested = false;
+				terminate = mTerminate;
 			}
-			mCV.notify_one();
 
-			if ( mTerminate and mMessageQueue.empty() )
+			DrainRings();
+			SubmitWriteBuffer();
+
+			if ( terminate )
 				break;
 		}
+
+		{
+			std::lock_guard< std::mutex > lock( mWriteMutex );
+			mWriterTerminate = true;
+		}
+		mWriteCV.notify_one();
+	}
+
+	void Logger::DrainRings()
+	{
+		SLC_PROFILE_FUNCTION();
+
+		{
+			std::scoped_lock< std::mutex > lock( mRingsMutex );
+			mDrainRings.assign( mRings.begin(), mRings.end() );
+		}
+
+		for ( auto& ring : mDrainRings )
+		{
+			std::size_t drained = ring->Drain( [ this ]( LogRecord const& record, std::span< const char > message ) {
+				// Deferred messages are formatted here, into a buffer owned by the worker, then copied like any other.
+				if ( record.format )
+				{
+					mFormatBuffer.clear();
+					record.format( message.data(), record.level, mFormatBuffer );
+
+					if ( mFormatBuffer.size() > mMessageSizeLimit )
+						mStats.large_message_count.fetch_add( 1, std::memory_order_relaxed );
+
+					message = mFormatBuffer;
+				}
+
+				// Messages are packed at their exact length, so short ones no longer take up a full size limit each.
+				const std::size_t length = std::min( message.size(), mCurrentBuffer->arena.Capacity() );
+
+				auto buffer = mCurrentBuffer->arena.RequestBuffer( length );
+				if ( not buffer.has_value() )
+				{
+					SubmitWriteBuffer();
+					buffer = mCurrentBuffer->arena.RequestBuffer( length );
+					ASSERT( buffer.has_value(), "Still could not create message buffer despite flush" );
+				}
+
+				message = message.first( length );
+				std::memcpy( buffer->data(), message.data(), message.size() );
+				mCurrentBuffer->queue.emplace_back( *buffer, message.size(), record.level, record.sequence );
+			} );
+
+			mPendingBytes.fetch_sub( drained, std::memory_order_relaxed );
+		}
+
+		mDrainRings.clear();
+	}
+
+	void Logger::SubmitWriteBuffer()
+	{
+		SLC_PROFILE_FUNCTION();
+
+		mLastFlush = Clock::now();
+
+		if ( mCurrentBuffer->queue.empty() )
+			return;
+
+		// Each ring is already in order, so sorting by the global sequence interleaves threads in posting order.
+		std::ranges::sort( mCurrentBuffer->queue, {}, &MessageEntry::sequence );
+
+		std::unique_lock< std::mutex > lock( mWriteMutex );
+		mPendingWrites.push_back( mCurrentBuffer );
+		mWriteCV.notify_one();
+
+		if ( mFreeBuffers.empty() )
+		{
+			SLC_PROFILE_SCOPE( "Logging - Wait for free write buffer" );
+
+			mStats.write_buffer_full_waits.fetch_add( 1, std::memory_order_relaxed );
+			mFreeBufferCV.wait( lock, [ this ] { return not mFreeBuffers.empty(); } );
+		}
+
+		mCurrentBuffer = mFreeBuffers.back();
+		mFreeBuffers.pop_back();
 	}
 
-	void slc::Logger::Flush()
+	void Logger::WriteBuffers()
+	{
+		while ( true )
+		{
+			WriteBuffer* buffer = nullptr;
+			{
+				std::unique_lock< std::mutex > lock( mWriteMutex );
+				mWriteCV.wait( lock, [ this ] { return not mPendingWrites.empty() or mWriterTerminate; } );
+
+				if ( mPendingWrites.empty() )
+					break;
+
+				buffer = mPendingWrites.front();
+				mPendingWrites.pop_front();
+			}
+
+			Flush( *buffer );
+
+			{
+				std::lock_guard< std::mutex > lock( mWriteMutex );
+				mFreeBuffers.push_back( buffer );
+			}
+			mFreeBufferCV.notify_one();
+		}
+	}
+
+	void slc::Logger::Flush( WriteBuffer& buffer )
 	{
 		SLC_PROFILE_FUNCTION();
 
@@ -151,7 +401,7 @@ namespace slc {
 
 			for ( auto const& target : mLogTargets )
 			{
-				target->WriteTarget( mMessageQueue );
+				target->WriteTarget( buffer.queue );
 				target->Flush();
 			}
 		}
@@ -161,28 +411,28 @@ namespace slc {
 
 			{
 				SLC_PROFILE_SCOPE( "Cleanup - Release buffer" );
-				mArena.ReleaseBuffers();
+				buffer.arena.ReleaseBuffers();
 			}
 			{
 				SLC_PROFILE_SCOPE( "Cleanup - Clear queue" );
-				mMessageQueue.clear();
+				buffer.queue.clear();
 			}
 		}
 
 		{
 			SLC_PROFILE_SCOPE( "Stats" );
 
-			mStats.total_flushes++;
-			mStats.large_message_count = 0;
-			mStats.messages_since_last_flush = 0;
+			mStats.total_flushes.fetch_add( 1, std::memory_order_relaxed );
+			mStats.large_message_count.store( 0, std::memory_order_relaxed );
+			mStats.messages_since_last_flush.store( 0, std::memory_order_relaxed );
 
 			auto flush_time = Clock::now();
-			mStats.time_since_last_flush = flush_time - mLastFlush;
-			mLastFlush = flush_time;
+			mStats.time_since_last_flush.store( flush_time - mLastWrite, std::memory_order_relaxed );
+			mLastWrite = flush_time;
 		}
 	}
 
-	void Logger::UpdateCurrentTimestamp()
+	const char* Logger::UpdateCurrentTimestamp()
 	{
 		SLC_PROFILE_FUNCTION();
 
@@ -192,10 +442,19 @@ namespace slc {
 			now = std::chrono::system_clock::now();
 		}
 
+		return FormatTimestamp( now );
+	}
+
+	const char* Logger::FormatTimestamp( std::chrono::system_clock::time_point now )
+	{
+		SLC_PROFILE_FUNCTION();
+
+		thread_local TimestampCache tTimestampCache;
+
 		{
 			SLC_PROFILE_SCOPE( "Update timestamp - Check if time is same" );
-			if ( std::chrono::floor< std::chrono::seconds >( now ) == std::chrono::floor< std::chrono::seconds >( mTimestampCache.timestamp ) )
-				return;
+			if ( std::chrono::floor< std::chrono::seconds >( now ) == std::chrono::floor< std::chrono::seconds >( tTimestampCache.timestamp ) )
+				return tTimestampCache.format_string.data();
 		}
 
 		std::time_t now_c{};
@@ -212,12 +471,14 @@ namespace slc {
 
 		{
 			SLC_PROFILE_SCOPE( "Update timestamp - update saved timestamp" );
-			mTimestampCache.timestamp = now;
+			tTimestampCache.timestamp = now;
 		}
 
 		{
 			SLC_PROFILE_SCOPE( "Update timestamp - Format time" );
-			std::strftime( mTimestampCache.format_string.data(), mTimestampCache.format_string.size(), "%F %T", &time );
+			std::strftime( tTimestampCache.format_string.data(), tTimestampCache.format_string.size(), "%F %T", &time );
 		}
+
+		return tTimestampCache.format_string.data();
 	}
 } // namespace slc
\ No newline at end of file
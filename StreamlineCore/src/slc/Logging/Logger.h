@@ -1,12 +1,16 @@
 #pragma once
 
 #include "LogMemoryArena.h"
+#include "LogRing.h"
 #include "Targets/ILogTarget.h"
 
 #include "slc/Common/Profiling.h"
 
+#include <condition_variable>
+#include <deque>
 #include <thread>
 #include <mutex>
+#include <tuple>
 
 namespace slc {
 
@@ -16,6 +20,8 @@ namespace slc {
 		SCONSTEXPR std::size_t MessageSizeLimit = 512;
 		SCONSTEXPR std::size_t MaxMessagesBeforeFlush = 1024;
 		SCONSTEXPR std::size_t TemporaryBufferSize = MessageSizeLimit;
+		SCONSTEXPR std::size_t RingCapacity = 64 * 1024;
+		SCONSTEXPR std::size_t WriteBufferCount = 2;
 
 		using TemporaryBuffer = std::array< char, MessageSizeLimit >;
 
@@ -31,21 +37,73 @@ namespace slc {
 			std::size_t messages_since_last_flush{};
 			Duration time_since_last_flush{};
 			std::size_t large_message_count{};
+			std::size_t ring_full_waits{};
+			std::size_t write_buffer_full_waits{};
+			std::size_t thread_rings{};
+		};
+
+		// Written by producers and the worker concurrently, so GetStats returns a snapshot.
+		struct AtomicLoggerStats
+		{
+			std::atomic_size_t total_flushes{};
+			std::atomic_size_t messages_since_last_flush{};
+			std::atomic< Duration > time_since_last_flush{};
+			std::atomic_size_t large_message_count{};
+			std::atomic_size_t ring_full_waits{};
+			std::atomic_size_t write_buffer_full_waits{};
+		};
+
+		// Messages drained from the rings, waiting to be written to the targets.
+		struct WriteBuffer
+		{
+			WriteBuffer( std::size_t arena_size )
+				: arena( arena_size )
+			{
+			}
+
+			LogMemoryArena arena;
+			std::vector< MessageEntry > queue;
 		};
 
 	public:
 		static Logger& GetGlobalLogger();
 		static Logger& GetErrorLogger();
 
+		/// <param name="message_size_limit">Space reserved for formatting a message in place. Longer messages are still logged, through a slower path.</param>
+		/// <param name="max_messages_before_flush">Sizes each write buffer to hold this many messages of the size limit.</param>
 		Logger( std::size_t message_size_limit = MessageSizeLimit, std::size_t max_messages_before_flus = MaxMessagesBeforeFlush );
 		~Logger();
 
-		LoggerStats const& GetStats() const
+		LoggerStats GetStats() const;
+
+		void SetLogLevel( LogLevel level );
+
+		void SetCategoryEnabled( LogCategory category, bool enabled )
 		{
-			return mStats;
+			if ( enabled )
+				mCategoryMask.fetch_or( LogCategoryBit( category ), std::memory_order_relaxed );
+			else
+				mCategoryMask.fetch_and( ~LogCategoryBit( category ), std::memory_order_relaxed );
 		}
 
-		void SetLogLevel( LogLevel level );
+		/// <summary>
+		/// Cheap check for callers that want to skip building a message's arguments when it would be dropped.
+		/// </summary>
+		bool IsEnabled( LogLevel level, LogCategory category = LogCategory::General ) const
+		{
+			return std::to_underlying( level ) >= std::to_underlying( mMinLogLevel.load( std::memory_order_relaxed ) ) and
+				   ( mCategoryMask.load( std::memory_order_relaxed ) & LogCategoryBit( category ) ) != 0;
+		}
+
+		/// <summary>
+		/// When enabled, messages whose arguments are all DeferrableLogArgument values are not formatted on the
+		/// calling thread. Only the format string and a copy of the arguments go into the ring, and the worker
+		/// runs std::format. Other messages are still formatted immediately.
+		/// </summary>
+		void SetDeferredFormatting( bool deferred )
+		{
+			mDeferredFormatting.store( deferred, std::memory_order_relaxed );
+		}
 
 		template < typename target_t, typename... Args >
 			requires std::derived_from< target_t, ILogTarget > and
@@ -63,100 +121,157 @@ namespace slc {
 		{
 			SLC_PROFILE_FUNCTION();
 
-			if ( std::to_underlying( level ) < std::to_underlying( mMinLogLevel ) )
+			if ( std::to_underlying( level ) < std::to_underlying( mMinLogLevel.load( std::memory_order_relaxed ) ) )
 				return;
 
-			auto buffer = mArena.RequestBuffer( mMessageSizeLimit );
-			if ( not buffer.has_value() )
-			{
-				{
-					SLC_PROFILE_SCOPE( "Logging - Notify" );
-					mCV.notify_one();
-				}
-
-				{
-					SLC_PROFILE_SCOPE( "Logging - Wait" );
+			LogRing* ring = GetThreadRing();
+			if ( not ring ) [[unlikely]]
+				return;
 
-					std::unique_lock< std::mutex > lock( mQueueMutex );
-					mCV.wait( lock, [ this ] { return mMessageQueue.size() < mMaxMessagesBeforeFlush; } );
-				}
+			MessageBuffer buffer = ring->Acquire( mMessageSizeLimit );
+			if ( buffer.empty() ) [[unlikely]]
+				buffer = WaitForRingSpace( *ring, mMessageSizeLimit );
 
+			if constexpr ( ( DeferrableLogArgument< Args > and ... ) )
+			{
+				using Payload = DeferredPayload< std::remove_cvref_t< Args >... >;
+				if ( sizeof( Payload ) <= buffer.size() and mDeferredFormatting.load( std::memory_order_relaxed ) )
 				{
-					SLC_PROFILE_SCOPE( "Logging - Get Buffer Retry" );
+					SLC_PROFILE_SCOPE( "Logging - Copy deferred arguments" );
+
+					ASSERT( reinterpret_cast< std::uintptr_t >( buffer.data() ) % alignof( Payload ) == 0, "Log ring slot is misaligned for deferred arguments" );
+					std::construct_at( reinterpret_cast< Payload* >( buffer.data() ), std::chrono::system_clock::now(), message.get(), std::tuple( args... ) );
 
-					buffer = mArena.RequestBuffer( mMessageSizeLimit );
-					ASSERT( buffer.has_value(), "Still could not create message buffer despite flush" );
+					PublishMessage( *ring, sizeof( Payload ), level, &FormatDeferred< std::remove_cvref_t< Args >... > );
+					return;
 				}
 			}
 
 			auto level_string = Enum::ToString( level );
-			UpdateCurrentTimestamp();
+			const char* timestamp = UpdateCurrentTimestamp();
 
 			std::size_t formatted_size{};
 			{
 				SLC_PROFILE_SCOPE( "Logging - Format message" );
 
-				auto formatted_message = GetFormatMessage( message, std::forward< Args >( args )... );
-				auto format_result = std::format_to_n( buffer->begin(), mMessageSizeLimit, "[{}] {}: {}", level_string, mTimestampCache.format_string.data(), formatted_message.data() );
-				formatted_size = std::min( static_cast< std::size_t >( format_result.size ), mMessageSizeLimit );
-			}
+				// Format straight into the space reserved in the ring. Only the bytes used are committed.
+				auto prefix_result = std::format_to_n( buffer.data(), buffer.size(), "[{}] {}: ", level_string, timestamp );
+				auto prefix_size = std::min( static_cast< std::size_t >( prefix_result.size ), buffer.size() );
 
+				auto format_result = std::format_to_n( buffer.data() + prefix_size, buffer.size() - prefix_size, message, std::forward< Args >( args )... );
+				formatted_size = prefix_size + static_cast< std::size_t >( format_result.size );
+			}
 
-			if ( formatted_size == mMessageSizeLimit )
-				mStats.large_message_count++;
-
+			if ( formatted_size > buffer.size() ) [[unlikely]]
 			{
-				SLC_PROFILE_SCOPE( "Logging - Lock queue and push" );
+				SLC_PROFILE_SCOPE( "Logging - Format large message" );
 
-				std::lock_guard< std::mutex > lock( mQueueMutex );
-				mMessageQueue.emplace_back( *buffer, formatted_size, level );
-			}
+				// Too long for the reservation, so format again into scratch space and reserve exactly enough.
+				std::string& scratch = GetScratchBuffer();
+				scratch.clear();
+				std::format_to( std::back_inserter( scratch ), "[{}] {}: ", level_string, timestamp );
+				std::format_to( std::back_inserter( scratch ), message, std::forward< Args >( args )... );
 
-			mStats.messages_since_last_flush++;
+				PublishLargeMessage( *ring, scratch, level );
+				return;
+			}
 
-			mCV.notify_one();
+			PublishMessage( *ring, formatted_size, level );
 		}
 
 	private:
 		void ProcessQueue();
-		void Flush();
+		void DrainRings();
+		void SubmitWriteBuffer();
+
+		void WriteBuffers();
+		void Flush( WriteBuffer& buffer );
+
+		LogRing* GetThreadRing();
+		LogRing* ClaimThreadRing();
+		MessageBuffer WaitForRingSpace( LogRing& ring, std::size_t size );
+		void PublishMessage( LogRing& ring, std::size_t formatted_size, LogLevel level, DeferredFormatFunction format = nullptr );
+		void PublishLargeMessage( LogRing& ring, std::string_view message, LogLevel level );
+
+		static std::string& GetScratchBuffer();
 
 		template < typename... Args >
-		TemporaryBuffer GetFormatMessage( std::format_string< Args... > message, Args&&... args )
+		struct DeferredPayload
+		{
+			std::chrono::system_clock::time_point timestamp;
+			std::string_view format;
+			std::tuple< Args... > args;
+		};
+
+		template < typename... Args >
+		static void FormatDeferred( const char* payload, LogLevel level, std::string& out )
 		{
 			SLC_PROFILE_FUNCTION();
 
-			TemporaryBuffer temp;
-			auto result = std::format_to_n( temp.data(), temp.size(), message, std::forward< Args >( args )... );
-			return temp;
+			using Payload = DeferredPayload< Args... >;
+			SASSERT( std::is_trivially_destructible_v< Payload > );
+
+			auto const& deferred = *std::launder( reinterpret_cast< const Payload* >( payload ) );
+
+			std::format_to( std::back_inserter( out ), "[{}] {}: ", Enum::ToString( level ), FormatTimestamp( deferred.timestamp ) );
+			std::apply( [ & ]( auto const&... args ) { std::vformat_to( std::back_inserter( out ), deferred.format, std::make_format_args( args... ) ); }, deferred.args );
 		}
 
-		void UpdateCurrentTimestamp();
+		struct TimestampCache
+		{
+			std::chrono::system_clock::time_point timestamp;
+			TemporaryBuffer format_string;
+		};
+
+		// Formatted timestamp for the current second, cached per thread.
+		static const char* UpdateCurrentTimestamp();
+		static const char* FormatTimestamp( std::chrono::system_clock::time_point now );
 
 	private:
 		std::thread mWorker;
-		std::mutex mQueueMutex;
+		std::mutex mWorkerMutex;
 		std::condition_variable mCV;
 		bool mTerminate;
+		bool mFlushRequested = false;
 
 		TimePoint mLastFlush;
 
-		LogLevel mMinLogLevel;
-		std::vector< MessageEntry > mMessageQueue;
+		std::atomic< LogLevel > mMinLogLevel;
+		std::atomic_uint64_t mCategoryMask = Limits< uint64_t >::Max;
+		std::atomic_bool mDeferredFormatting = false;
 		std::vector< Unique< ILogTarget > > mLogTargets;
 
-		LogMemoryArena mArena;
-		std::vector< char > mMessageBuffer;
-
-		LoggerStats mStats;
-
-		struct TimestampCache
-		{
-			std::chrono::system_clock::time_point timestamp;
-			TemporaryBuffer format_string;
-		} mTimestampCache;
+		// Producer side. Each thread that logs gets its own ring; the mutex is only taken to hand one out.
+		uint64_t mId;
+		mutable std::mutex mRingsMutex;
+		std::vector< Ref< LogRing > > mRings;
+		std::atomic_uint64_t mSequence = 0;
+		std::atomic_size_t mPendingBytes = 0;
+
+		// Worker side. Only touched by the worker thread.
+		std::vector< Ref< LogRing > > mDrainRings;
+		WriteBuffer* mCurrentBuffer = nullptr;
+		std::string mFormatBuffer;
+
+		// Writer side. The worker hands full buffers to the writer thread, which does all target I/O, so
+		// draining the rings only stops if every write buffer is waiting to be written.
+		std::thread mWriter;
+		std::mutex mWriteMutex;
+		std::condition_variable mWriteCV;
+		std::condition_variable mFreeBufferCV;
+		std::vector< Unique< WriteBuffer > > mWriteBuffers;
+		std::deque< WriteBuffer* > mPendingWrites;
+		std::vector< WriteBuffer* > mFreeBuffers;
+		bool mWriterTerminate = false;
+		TimePoint mLastWrite;
+
+		AtomicLoggerStats mStats;
 
 		std::size_t mMessageSizeLimit;
 		std::size_t mMaxMessagesBeforeFlush;
+		std::size_t mRingCapacity;
+		// Pending bytes that wake the worker early. At most half a ring, so a single busy thread wakes it
+		// before its ring fills rather than stalling in WaitForRingSpace.
+		std::size_t mFlushThreshold;
 	};
 } // namespace slc
\ No newline at end of file
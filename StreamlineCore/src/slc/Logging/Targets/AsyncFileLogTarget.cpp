@@ -0,0 +1,266 @@
+#include "AsyncFileLogTarget.h"
+
+#ifdef SLC_PLATFORM_LINUX
+
+#include "slc/Common/Profiling.h"
+#include "slc/Common/Time.h"
+#include "slc/Logging/Logger.h"
+
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace slc {
+
+	AsyncFileLogTarget::AsyncFileLogTarget( const fs::path& path, LogLevel level, AsyncFileLogOptions options )
+		: ILogTarget( level )
+		, mPath( path )
+		, mPreparedPath( fs::path( path ).concat( ".next" ) )
+		, mOptions( options )
+		, mFileOpened( Clock::now() )
+	{
+		// A failure is left for the first write to report and retry. This constructor must not call the error
+		// logger, which may be what is being constructed.
+		Reopen();
+
+		// Keep the next file ready so a rotation never has to wait for open and fallocate.
+		mPrepareRequested = mOptions.maxFileSize > 0 or mOptions.rotationInterval.count() > 0;
+
+		mBackground = std::thread( &AsyncFileLogTarget::RunBackground, this );
+	}
+
+	AsyncFileLogTarget::~AsyncFileLogTarget()
+	{
+		{
+			std::lock_guard< std::mutex > lock( mMutex );
+			mStop = true;
+		}
+		mCV.notify_one();
+		mBackground.join();
+
+		if ( mFile != -1 )
+			CloseFile( mFile );
+
+		if ( mPreparedFile != -1 )
+		{
+			::close( mPreparedFile );
+			std::error_code error;
+			fs::remove( mPreparedPath, error );
+		}
+	}
+
+	void AsyncFileLogTarget::DoWriteTarget()
+	{
+		SLC_PROFILE_FUNCTION();
+
+		if ( ShouldRotate() )
+			Rotate();
+
+		// Either the constructor or an unprepared rotation could not open the file. Keep trying rather than
+		// dropping every message from here on.
+		if ( mFile == -1 and not Reopen() )
+		{
+			if ( not mWriteFailed )
+			{
+				auto message = std::system_category().message( errno );
+				Logger::GetErrorLogger().Log( LogLevel::Error, "Failed to open log file {} [{}]", mPath.string(), message );
+			}
+
+			mWriteFailed = true;
+			return;
+		}
+
+		bool success = WriteFragments( mFile, mFragments );
+		if ( success )
+		{
+			mFileSize += mToWrite;
+		}
+		else if ( not mWriteFailed )
+		{
+			auto message = std::system_category().message( errno );
+			Logger::GetErrorLogger().Log( LogLevel::Error, "Failed to write to log file {} [{}]", mPath.string(), message );
+		}
+
+		mWriteFailed = not success;
+	}
+
+	void AsyncFileLogTarget::DoPreFlush()
+	{
+	}
+
+	void AsyncFileLogTarget::DoFlush()
+	{
+		if ( mOptions.syncPolicy == FileSyncPolicy::EveryFlush and mFile != -1 )
+		{
+			SLC_PROFILE_SCOPE( "Logging - fdatasync" );
+			::fdatasync( mFile );
+		}
+	}
+
+	bool AsyncFileLogTarget::ShouldRotate() const
+	{
+		if ( mFileSize == 0 )
+			return false;
+
+		if ( mOptions.maxFileSize > 0 and mFileSize + mToWrite > mOptions.maxFileSize )
+			return true;
+
+		return mOptions.rotationInterval.count() > 0 and Clock::now() - mFileOpened >= mOptions.rotationInterval;
+	}
+
+	void AsyncFileLogTarget::Rotate()
+	{
+		SLC_PROFILE_FUNCTION();
+
+		int next = -1;
+		{
+			std::lock_guard< std::mutex > lock( mMutex );
+			std::swap( next, mPreparedFile );
+		}
+
+		std::error_code error;
+		fs::rename( mPath, NextRotatedPath(), error );
+
+		if ( next != -1 )
+		{
+			fs::rename( mPreparedPath, mPath, error );
+		}
+		else
+		{
+			// If this fails too, mFile is left at -1 and DoWriteTarget reports it and retries.
+			mUnpreparedRotationCount++;
+			next = OpenFile( mPath, true );
+		}
+
+		{
+			std::lock_guard< std::mutex > lock( mMutex );
+			if ( mFile != -1 )
+				mRetiredFiles.push_back( mFile );
+
+			mFile = next;
+			mPrepareRequested = true;
+		}
+		mCV.notify_one();
+
+		mFileSize = 0;
+		mFileOpened = Clock::now();
+		mRotationCount++;
+	}
+
+	fs::path AsyncFileLogTarget::NextRotatedPath()
+	{
+		std::time_t now = std::chrono::system_clock::to_time_t( std::chrono::system_clock::now() );
+		std::tm time = GetLocalTime( &now );
+
+		char timestamp[ 32 ]{};
+		std::strftime( timestamp, sizeof( timestamp ), "%Y%m%d-%H%M%S", &time );
+
+		// The rotation count keeps names unique when rotating more than once a second.
+		fs::path rotated = mPath.parent_path() / mPath.stem();
+		rotated.concat( std::format( ".{}.{}", timestamp, mRotationCount ) );
+		rotated.concat( mPath.extension().string() );
+		return rotated;
+	}
+
+	bool AsyncFileLogTarget::Reopen()
+	{
+		int file = OpenFile( mPath, false );
+		if ( file == -1 )
+			return false;
+
+		// Appending to an existing file, so reserve the space past its current end.
+		struct stat info{};
+		mFileSize = ::fstat( file, &info ) == 0 ? static_cast< std::size_t >( info.st_size ) : 0;
+		if ( mFileSize > 0 and mOptions.preallocateSize > 0 )
+			::fallocate( file, FALLOC_FL_KEEP_SIZE, static_cast< off_t >( mFileSize ), static_cast< off_t >( mOptions.preallocateSize ) );
+
+		{
+			std::lock_guard< std::mutex > lock( mMutex );
+			mFile = file;
+		}
+		mFileOpened = Clock::now();
+		return true;
+	}
+
+	int AsyncFileLogTarget::OpenFile( const fs::path& path, bool truncate ) const
+	{
+		int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC;
+		if ( truncate )
+			flags |= O_TRUNC;
+
+		int file = ::open( path.c_str(), flags, 0644 );
+		if ( file != -1 and mOptions.preallocateSize > 0 )
+			::fallocate( file, FALLOC_FL_KEEP_SIZE, 0, static_cast< off_t >( mOptions.preallocateSize ) );
+
+		return file;
+	}
+
+	void AsyncFileLogTarget::CloseFile( int file ) const
+	{
+		// Give back the preallocated blocks past the end of the file.
+		struct stat info{};
+		if ( mOptions.preallocateSize > 0 and ::fstat( file, &info ) == 0 )
+			::ftruncate( file, info.st_size );
+
+		if ( mOptions.syncPolicy != FileSyncPolicy::None )
+			::fdatasync( file );
+
+		::close( file );
+	}
+
+	void AsyncFileLogTarget::RunBackground()
+	{
+		const bool interval_sync = mOptions.syncPolicy == FileSyncPolicy::Interval;
+		auto next_sync = Clock::now() + mOptions.syncInterval;
+
+		std::unique_lock< std::mutex > lock( mMutex );
+		while ( true )
+		{
+			auto wake = interval_sync ? next_sync : Clock::time_point::max();
+			mCV.wait_until( lock, wake, [ this ] { return mStop or ( mPrepareRequested and mPreparedFile == -1 ) or not mRetiredFiles.empty(); } );
+
+			if ( mPrepareRequested and mPreparedFile == -1 and not mStop )
+			{
+				lock.unlock();
+				int prepared = OpenFile( mPreparedPath, true );
+				lock.lock();
+
+				mPreparedFile = prepared;
+				mPrepareRequested = false;
+			}
+
+			if ( not mRetiredFiles.empty() )
+			{
+				auto retired = std::move( mRetiredFiles );
+				mRetiredFiles.clear();
+
+				lock.unlock();
+				for ( int file : retired )
+					CloseFile( file );
+				lock.lock();
+			}
+
+			if ( interval_sync and Clock::now() >= next_sync )
+			{
+				// Sync a duplicate so Rotate can retire and close the current descriptor without waiting on the disk.
+				int file = mFile != -1 ? ::dup( mFile ) : -1;
+				if ( file != -1 )
+				{
+					lock.unlock();
+					::fdatasync( file );
+					::close( file );
+					lock.lock();
+				}
+
+				next_sync = Clock::now() + mOptions.syncInterval;
+			}
+
+			if ( mStop )
+				break;
+		}
+	}
+} // namespace slc
+
+#endif // SLC_PLATFORM_LINUX
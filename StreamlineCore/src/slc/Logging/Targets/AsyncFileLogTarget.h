@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ILogTarget.h"
+
+#include "slc/Common/Base.h"
+
+#ifdef SLC_PLATFORM_LINUX
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace slc {
+
+	enum class FileSyncPolicy
+	{
+		// Leave write back to the OS.
+		None,
+		// fdatasync the current file from the background thread every syncInterval.
+		Interval,
+		// fdatasync after every flush on the writer thread. Durable, but each flush waits for the disk.
+		EveryFlush
+	};
+
+	struct AsyncFileLogOptions
+	{
+		/// <summary>
+		/// Rotate once the current file reaches this many bytes. 0 disables size based rotation.
+		/// </summary>
+		std::size_t maxFileSize = 512 * 1024 * 1024;
+
+		/// <summary>
+		/// Rotate once the current file has been open this long. 0 disables time based rotation.
+		/// </summary>
+		std::chrono::seconds rotationInterval{ 0 };
+
+		/// <summary>
+		/// Disk space reserved with fallocate when a file is opened, so appends do not allocate blocks as they go.
+		/// The reported file size is unchanged.
+		/// </summary>
+		std::size_t preallocateSize = 64 * 1024 * 1024;
+
+		FileSyncPolicy syncPolicy = FileSyncPolicy::None;
+		std::chrono::milliseconds syncInterval{ 1000 };
+	};
+
+	/// <summary>
+	/// Append-only log file written through a raw file descriptor with one writev per flush. Everything slow is
+	/// kept off the writer thread by a background thread: the next file is opened and preallocated ahead of
+	/// time, rotated files are synced and closed there, and interval syncs run there too. A rotation on the
+	/// writer thread is then just two renames and a descriptor swap.
+	///
+	/// The active file is always at path. Rotated files are renamed to stem.YYYYmmdd-HHMMSS.N.ext beside it.
+	/// </summary>
+	class AsyncFileLogTarget : public ILogTarget
+	{
+	public:
+		AsyncFileLogTarget( const fs::path& path, LogLevel level = LogLevel::Debug, AsyncFileLogOptions options = {} );
+		~AsyncFileLogTarget();
+
+		AsyncFileLogTarget( const AsyncFileLogTarget& ) = delete;
+		auto operator=( const AsyncFileLogTarget& ) = delete;
+
+		std::size_t GetRotationCount() const
+		{
+			return mRotationCount;
+		}
+
+		/// <summary>
+		/// Rotations that had to open the next file on the writer thread because it was not prepared in time.
+		/// </summary>
+		std::size_t GetUnpreparedRotationCount() const
+		{
+			return mUnpreparedRotationCount;
+		}
+
+	private:
+		void DoWriteTarget() override;
+		void DoPreFlush() override;
+		void DoFlush() override;
+
+		bool ShouldRotate() const;
+		void Rotate();
+		fs::path NextRotatedPath();
+
+		bool Reopen();
+		int OpenFile( const fs::path& path, bool truncate ) const;
+		void CloseFile( int file ) const;
+
+		void RunBackground();
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		fs::path mPath;
+		fs::path mPreparedPath;
+		AsyncFileLogOptions mOptions;
+
+		// Writer thread only, except that mFile is swapped under mMutex for the background thread's syncs.
+		int mFile = -1;
+		std::size_t mFileSize = 0;
+		Clock::time_point mFileOpened;
+		std::size_t mRotationCount = 0;
+		std::size_t mUnpreparedRotationCount = 0;
+		// Failures are reported once until a write succeeds again, as in FileLogTarget.
+		bool mWriteFailed = false;
+
+		// Shared with the background thread.
+		std::thread mBackground;
+		std::mutex mMutex;
+		std::condition_variable mCV;
+		bool mStop = false;
+		bool mPrepareRequested = false;
+		int mPreparedFile = -1;
+		std::vector< int > mRetiredFiles;
+	};
+} // namespace slc
+
+#endif // SLC_PLATFORM_LINUX
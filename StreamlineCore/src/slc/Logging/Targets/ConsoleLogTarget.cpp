@@ -10,7 +10,7 @@
 
 #ifdef SLC_PLATFORM_WINDOWS
 #include "Windows.h"
-#elif defined( SLC_PLATFORM_WINDOWS )
+#elif defined( SLC_PLATFORM_LINUX )
 #include <unistd.h>
 #endif
 
@@ -54,7 +54,10 @@ namespace {
 #endif // SLC_PLATFORM_WINDOWS
 	}
 
-	static void WriteToConsoleNative( std::span< const char > buffer, std::size_t count )
+	SCONSTEXPR std::string_view ResetColourCode = "\x1b[0m";
+
+#ifndef SLC_PLATFORM_LINUX
+	static void WriteToConsoleNative( std::span< const char > buffer )
 	{
 #ifdef SLC_PLATFORM_WINDOWS
 		HANDLE hStdOut = GetStdHandle( STD_OUTPUT_HANDLE );
@@ -68,35 +71,28 @@ namespace {
 		}
 
 		DWORD bytesWritten;
-		BOOL success = WriteConsoleA( hStdOut, buffer.data(), static_cast< DWORD >( count ), &bytesWritten, nullptr );
+		BOOL success = WriteConsoleA( hStdOut, buffer.data(), static_cast< DWORD >( buffer.size() ), &bytesWritten, nullptr );
 
 		if ( not success )
 		{
 			auto error = GetLastError();
 			auto message = std::system_category().message( error );
 
-			Logger::GetErrorLogger().Log( LogLevel::Error, "Failed to write to stdout [{}]", message );
-			return;
-		}
-#elif defined( SLC_PLATFORM_LINUX )
-		auto result = ::write( STDOUT_FILENO, mMessageBuffer.data(), count );
-		if ( result == -1 )
-		{
-			auto message = std::system_category().message( errno );
 			Logger::GetErrorLogger().Log( LogLevel::Error, "Failed to write to stdout [{}]", message );
 			return;
 		}
 #else
-		std::fwrite( buffer.data(), 1, buffer.mToWrite(), stdout );
+		std::fwrite( buffer.data(), 1, buffer.size(), stdout );
 #endif
 	}
+#endif // SLC_PLATFORM_LINUX
 
 	static void FlushConsoleNative()
 	{
 #ifdef SLC_PLATFORM_WINDOWS
 		// Used WriteConsoleA - flush not necessary
 #elif defined( SLC_PLATFORM_LINUX )
-		// Used ::write - flush not necessary
+		// Used ::writev - flush not necessary
 #else
 		std::fflush( stdout );
 #endif
@@ -114,7 +110,18 @@ namespace slc {
 
 	void ConsoleLogTarget::DoWriteTarget()
 	{
-		WriteToConsoleNative( mBuffer, mToWrite );
+		SLC_PROFILE_FUNCTION();
+
+#ifdef SLC_PLATFORM_LINUX
+		// One writev straight from the message arena, with colour codes from mColourCodes.
+		if ( not WriteFragments( STDOUT_FILENO, mFragments ) )
+		{
+			auto message = std::system_category().message( errno );
+			Logger::GetErrorLogger().Log( LogLevel::Error, "Failed to write to stdout [{}]", message );
+		}
+#else
+		WriteToConsoleNative( GatherFragments() );
+#endif
 	}
 
 	void ConsoleLogTarget::DoPreFlush()
@@ -126,14 +133,12 @@ namespace slc {
 		FlushConsoleNative();
 	}
 
-	void ConsoleLogTarget::PopulateBuffer( std::span< MessageEntry > data )
+	void ConsoleLogTarget::PopulateFragments( std::span< MessageEntry > data )
 	{
 		SLC_PROFILE_FUNCTION();
 
 		auto filtered_data = data | std::views::filter( [ this ]( auto const& entry ) { return ShouldWriteMessage( entry ); } );
 
-		mToWrite = 0;
-
 		if ( filtered_data.empty() )
 			return;
 
@@ -142,12 +147,12 @@ namespace slc {
 
 		for ( auto it = filtered_data.begin(); it != filtered_data.end(); ++it )
 		{
-			PopulateBufferSingleEntry( *it );
+			AddFragmentSingleEntry( *it );
 
 			if ( auto next = std::next( it ); next != filtered_data.end() )
 				WriteColourCode( next->level );
 
-			PopulateBufferNewLine();
+			AddFragmentNewLine();
 		}
 
 		WriteResetColourCode();
@@ -161,46 +166,45 @@ namespace slc {
 
 		mCurrentAttribute = next_colour;
 
-		mBuffer[ mToWrite ] = '\x1b';
-		mToWrite++;
-
-		mBuffer[ mToWrite ] = '[';
-		mToWrite++;
+		// Escape sequences are built once per attribute and kept, so fragments can point at them.
+		auto it = mColourCodes.find( next_colour );
+		if ( it == mColourCodes.end() )
+			it = mColourCodes.emplace( next_colour, BuildColourCode( next_colour ) ).first;
 
-		WriteStyleAttribute( next_colour & ConsoleAttributes::StyleMask );
+		AddFragment( it->second.data(), it->second.size() );
+	}
 
-		auto foreground = next_colour & ConsoleAttributes::ForegroundMask ? next_colour & ConsoleAttributes::ForegroundMask : ConsoleAttributes::DefaultForeground;
-		auto background = next_colour & ConsoleAttributes::BackgroundMask ? next_colour & ConsoleAttributes::BackgroundMask : ConsoleAttributes::DefaultBackground;
-		;
+	std::string ConsoleLogTarget::BuildColourCode( ConsoleAttributes::Attribute attribute )
+	{
+		std::string code = "\x1b[";
 
-		mBuffer[ mToWrite ] = '3';
-		mToWrite++;
+		WriteStyleAttribute( code, attribute & ConsoleAttributes::StyleMask );
 
-		WriteColourAttribute( foreground );
+		auto foreground = attribute & ConsoleAttributes::ForegroundMask ? attribute & ConsoleAttributes::ForegroundMask : ConsoleAttributes::DefaultForeground;
+		auto background = attribute & ConsoleAttributes::BackgroundMask ? attribute & ConsoleAttributes::BackgroundMask : ConsoleAttributes::DefaultBackground;
 
-		mBuffer[ mToWrite ] = ';';
-		mToWrite++;
+		code += '3';
+		WriteColourAttribute( code, foreground );
 
-		mBuffer[ mToWrite ] = '4';
-		mToWrite++;
+		code += ';';
 
-		WriteColourAttribute( ( background ) >> 8 );
+		code += '4';
+		WriteColourAttribute( code, ( background ) >> 8 );
 
-		mBuffer[ mToWrite ] = 'm';
-		mToWrite++;
+		code += 'm';
+		return code;
 	}
 
-	void ConsoleLogTarget::WriteColourAttribute( ConsoleAttributes::Attribute colour )
+	void ConsoleLogTarget::WriteColourAttribute( std::string& code, ConsoleAttributes::Attribute colour )
 	{
 		// Number of zero bits to right of 1 is the colour code
 		// E.g. White... = 128 = 0b10000000 = 7 zeros -> '7'
 
 		auto colour_value = static_cast< char >( std::countr_zero( colour ) ) + '0';
-		mBuffer[ mToWrite ] = colour_value;
-		mToWrite++;
+		code += static_cast< char >( colour_value );
 	}
 
-	void ConsoleLogTarget::WriteStyleAttribute( ConsoleAttributes::Attribute style )
+	void ConsoleLogTarget::WriteStyleAttribute( std::string& code, ConsoleAttributes::Attribute style )
 	{
 		if ( not( style & ConsoleAttributes::StyleMask ) )
 			return;
@@ -213,29 +217,16 @@ namespace slc {
 			if ( style_bits & bit_to_check )
 			{
 				auto style_value = ( i + 1 ) + '0';
-				mBuffer[ mToWrite ] = style_value;
-				mToWrite++;
-
-				mBuffer[ mToWrite ] = ';';
-				mToWrite++;
+				code += static_cast< char >( style_value );
+				code += ';';
 			}
 		}
 	}
 
 	void ConsoleLogTarget::WriteResetColourCode()
 	{
-		mBuffer[ mToWrite ] = '\x1b';
-		mToWrite++;
-
-		mBuffer[ mToWrite ] = '[';
-		mToWrite++;
-
-		mBuffer[ mToWrite ] = '0';
-		mToWrite++;
-
-		mBuffer[ mToWrite ] = 'm';
-		mToWrite++;
+		AddFragment( ResetColourCode.data(), ResetColourCode.size() );
 
 		mCurrentAttribute = ConsoleAttributes::Default;
 	}
-} // namespace slc
\ No newline at end of file
+} // namespace slc
@@ -3,6 +3,7 @@
 #include "ILogTarget.h"
 
 #include <map>
+#include <string>
 
 namespace slc {
 
@@ -59,15 +60,18 @@ namespace slc {
 		void DoPreFlush() override;
 		void DoFlush() override;
 
-		void PopulateBuffer( std::span< MessageEntry > data ) override;
+		void PopulateFragments( std::span< MessageEntry > data ) override;
 
 		void WriteColourCode( LogLevel level );
-		void WriteColourAttribute( ConsoleAttributes::Attribute colour );
-		void WriteStyleAttribute( ConsoleAttributes::Attribute style );
 		void WriteResetColourCode();
 
+		static std::string BuildColourCode( ConsoleAttributes::Attribute attribute );
+		static void WriteColourAttribute( std::string& code, ConsoleAttributes::Attribute colour );
+		static void WriteStyleAttribute( std::string& code, ConsoleAttributes::Attribute style );
+
 	private:
 		std::map< LogLevel, ConsoleAttributes::Attribute > mColours;
+		std::map< ConsoleAttributes::Attribute, std::string > mColourCodes;
 		ConsoleAttributes::Attribute mCurrentAttribute{};
 	};
 } // namespace slc
\ No newline at end of file
@@ -1,25 +1,89 @@
 #include "FileLogTarget.h"
 
+#include "slc/Common/Profiling.h"
+#include "slc/Logging/Logger.h"
+
+#include <format>
+#include <system_error>
+
+#ifdef SLC_PLATFORM_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace slc {
 	FileLogTarget::FileLogTarget( std::string const& filename, LogLevel level )
 		: ILogTarget( level )
+#ifdef SLC_PLATFORM_LINUX
+		, mFile{ ::open( filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 ) }
+#else
 		, mFile{ filename, std::ios::out | std::ios::app | std::ios::binary }
+#endif
+	{
+		// Reported on the first write rather than here: this may be the error logger's own target, constructed
+		// while the error logger is still being initialised.
+#ifdef SLC_PLATFORM_LINUX
+		if ( mFile == -1 )
+			mOpenError = std::format( "Failed to open log file {} [{}]", filename, std::system_category().message( errno ) );
+#else
+		if ( not mFile )
+			mOpenError = std::format( "Failed to open log file {}", filename );
+#endif
+	}
+
+	FileLogTarget::~FileLogTarget()
 	{
+#ifdef SLC_PLATFORM_LINUX
+		if ( mFile != -1 )
+			::close( mFile );
+#endif
 	}
 
 	void FileLogTarget::DoWriteTarget()
 	{
-		mFile.write( mBuffer.data(), mToWrite );
+		SLC_PROFILE_FUNCTION();
+
+		if ( not mOpenError.empty() )
+		{
+			if ( not mWriteFailed )
+				Logger::GetErrorLogger().Log( LogLevel::Error, mOpenError );
+
+			mWriteFailed = true;
+			return;
+		}
+
+#ifdef SLC_PLATFORM_LINUX
+		// One writev straight from the message arena.
+
+		bool success = WriteFragments( mFile, mFragments );
+		if ( not success and not mWriteFailed )
+		{
+			auto message = std::system_category().message( errno );
+			Logger::GetErrorLogger().Log( LogLevel::Error, "Failed to write to log file [{}]", message );
+		}
+#else
+		auto buffer = GatherFragments();
+		bool success = static_cast< bool >( mFile.write( buffer.data(), buffer.size() ) );
+		if ( not success )
+		{
+			mFile.clear();
+			if ( not mWriteFailed )
+				Logger::GetErrorLogger().Log( LogLevel::Error, "Failed to write to log file" );
+		}
+#endif
+		mWriteFailed = not success;
 	}
 
 	void FileLogTarget::DoPreFlush()
 	{
-		mFile.rdbuf()->pubsetbuf( mBuffer.data(), mBuffer.size() );
 	}
 
 	void FileLogTarget::DoFlush()
 	{
+#ifdef SLC_PLATFORM_LINUX
+		// Written with ::writev - flush not necessary
+#else
 		mFile << std::flush;
-		mFile.rdbuf()->pubsetbuf( nullptr, 0 );
+#endif
 	}
-} // namespace slc
\ No newline at end of file
+} // namespace slc
@@ -10,6 +10,10 @@ namespace slc {
 	{
 	public:
 		FileLogTarget( const std::string& filename, LogLevel level = LogLevel::Debug );
+		~FileLogTarget();
+
+		FileLogTarget( const FileLogTarget& ) = delete;
+		auto operator=( const FileLogTarget& ) = delete;
 
 	private:
 		void DoWriteTarget() override;
@@ -17,6 +21,14 @@ namespace slc {
 		void DoFlush() override;
 
 	private:
+#ifdef SLC_PLATFORM_LINUX
+		int mFile = -1;
+#else
 		std::ofstream mFile;
+#endif
+		// Failures are reported once until a write succeeds again. The error logger writes to a file target too,
+		// so reporting every failure of its own file would keep it busy forever.
+		bool mWriteFailed = false;
+		std::string mOpenError;
 	};
-} // namespace slc
\ No newline at end of file
+} // namespace slc
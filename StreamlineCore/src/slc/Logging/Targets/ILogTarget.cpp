@@ -3,20 +3,36 @@
 #include "slc/Common/Base.h"
 #include "slc/Common/Profiling.h"
 
-#include <ranges>
+#ifdef SLC_PLATFORM_LINUX
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+#endif
 
 namespace slc {
 
+	namespace {
+
+#ifdef SLC_PLATFORM_WINDOWS
+		constexpr std::string_view NewLine = "\r\n";
+#else
+		constexpr std::string_view NewLine = "\n";
+#endif // SLC_PLATFORM_WINDOWS
+	} // namespace
+
 	void ILogTarget::SetInitialBufferSize( std::size_t size )
 	{
-		mBuffer.resize( size );
+		mBuffer.reserve( size );
 	}
 
 	void ILogTarget::WriteTarget( std::span< MessageEntry > data )
 	{
 		SLC_PROFILE_FUNCTION();
 
-		PopulateBuffer( data );
+		mFragments.clear();
+		mToWrite = 0;
+
+		PopulateFragments( data );
 
 		if ( mToWrite == 0 )
 			return;
@@ -24,34 +40,89 @@ namespace slc {
 		DoWriteTarget();
 	}
 
-	void ILogTarget::PopulateBuffer( std::span< MessageEntry > data )
+	void ILogTarget::PopulateFragments( std::span< MessageEntry > data )
 	{
 		SLC_PROFILE_FUNCTION();
 
-		auto filtered_data = data | std::views::filter( [ this ]( auto const& entry ) { return ShouldWriteMessage( entry ); } ) | std::ranges::to< std::vector >();
-
-		mToWrite = 0;
-
-		for ( auto& entry : filtered_data )
+		for ( auto const& entry : data )
 		{
-			PopulateBufferSingleEntry( entry );
-			PopulateBufferNewLine();
+			if ( not ShouldWriteMessage( entry ) )
+				continue;
+
+			AddFragmentSingleEntry( entry );
+			AddFragmentNewLine();
 		}
 	}
-	void ILogTarget::PopulateBufferSingleEntry( MessageEntry const& entry )
+
+	void ILogTarget::AddFragment( const char* data, std::size_t size )
 	{
-		std::memcpy( mBuffer.data() + mToWrite, entry.message.data(), entry.length );
-		mToWrite += entry.length;
+		if ( size == 0 )
+			return;
+
+		// writev takes non-const pointers but only reads through them.
+		mFragments.push_back( { const_cast< char* >( data ), size } );
+		mToWrite += size;
 	}
 
-	void ILogTarget::PopulateBufferNewLine()
+	void ILogTarget::AddFragmentSingleEntry( MessageEntry const& entry )
 	{
-#ifdef SLC_PLATFORM_WINDOWS
-		mBuffer[ mToWrite ] = '\r';
-		mToWrite++;
-#endif // SLC_PLATFORM_WINDOWS
+		AddFragment( entry.message.data(), entry.length );
+	}
+
+	void ILogTarget::AddFragmentNewLine()
+	{
+		AddFragment( NewLine.data(), NewLine.size() );
+	}
+
+	std::span< const char > ILogTarget::GatherFragments()
+	{
+		SLC_PROFILE_FUNCTION();
+
+		mBuffer.resize( mToWrite );
+
+		std::size_t offset = 0;
+		for ( auto const& fragment : mFragments )
+		{
+			std::memcpy( mBuffer.data() + offset, fragment.iov_base, fragment.iov_len );
+			offset += fragment.iov_len;
+		}
+
+		return { mBuffer.data(), mToWrite };
+	}
+
+#ifdef SLC_PLATFORM_LINUX
+	bool ILogTarget::WriteFragments( int fd, std::span< LogFragment > fragments )
+	{
+		SLC_PROFILE_FUNCTION();
+
+		while ( not fragments.empty() )
+		{
+			const int count = static_cast< int >( std::min< std::size_t >( fragments.size(), IOV_MAX ) );
+			ssize_t written = ::writev( fd, fragments.data(), count );
+			if ( written < 0 )
+			{
+				if ( errno == EINTR )
+					continue;
+
+				return false;
+			}
+
+			// Skip whole fragments that were written, then trim the one the write stopped in.
+			auto remaining = static_cast< std::size_t >( written );
+			while ( not fragments.empty() and remaining >= fragments.front().iov_len )
+			{
+				remaining -= fragments.front().iov_len;
+				fragments = fragments.subspan( 1 );
+			}
+
+			if ( remaining > 0 )
+			{
+				fragments.front().iov_base = static_cast< char* >( fragments.front().iov_base ) + remaining;
+				fragments.front().iov_len -= remaining;
+			}
+		}
 
-		mBuffer[ mToWrite ] = '\n';
-		mToWrite++;
+		return true;
 	}
-} // namespace slc
\ No newline at end of file
+#endif
+} // namespace slc
@@ -2,10 +2,26 @@
 
 #include "../Common.h"
 
+#include "slc/Common/Platform.h"
+
 #include <vector>
 
+#ifdef SLC_PLATFORM_LINUX
+#include <sys/uio.h>
+#endif
+
 namespace slc {
 
+#ifdef SLC_PLATFORM_LINUX
+	using LogFragment = ::iovec;
+#else
+	struct LogFragment
+	{
+		void* iov_base;
+		std::size_t iov_len;
+	};
+#endif
+
 	class ILogTarget
 	{
 	public:
@@ -39,11 +55,27 @@ namespace slc {
 		virtual void DoPreFlush() = 0;
 		virtual void DoFlush() = 0;
 
-		virtual void PopulateBuffer( std::span< MessageEntry > data );
+		virtual void PopulateFragments( std::span< MessageEntry > data );
 
 	protected:
-		void PopulateBufferSingleEntry( MessageEntry const& entry );
-		void PopulateBufferNewLine();
+		// Fragments point straight at the message arena or at static/member storage, so nothing is copied
+		// until the write itself. They are only valid until WriteTarget returns.
+		void AddFragment( const char* data, std::size_t size );
+		void AddFragmentSingleEntry( MessageEntry const& entry );
+		void AddFragmentNewLine();
+
+		/// <summary>
+		/// Copy every fragment into mBuffer, grown to fit, for platforms without vectored writes.
+		/// </summary>
+		std::span< const char > GatherFragments();
+
+#ifdef SLC_PLATFORM_LINUX
+		/// <summary>
+		/// Write all fragments to a file descriptor with writev, resuming after partial writes.
+		/// Returns false and sets errno on failure.
+		/// </summary>
+		static bool WriteFragments( int fd, std::span< LogFragment > fragments );
+#endif
 
 		bool ShouldWriteMessage( MessageEntry const& entry ) const
 		{
@@ -51,10 +83,12 @@ namespace slc {
 		}
 
 	protected:
+		std::vector< LogFragment > mFragments;
+		std::size_t mToWrite = 0;
+
 		std::vector< char > mBuffer;
-		std::size_t mToWrite;
 
 	private:
 		LogLevel mLogLevel;
 	};
-} // namespace slc
\ No newline at end of file
+} // namespace slc
@@ -0,0 +1,197 @@
+#include "MmapLogTarget.h"
+
+#include "slc/Common/Profiling.h"
+
+#ifdef SLC_PLATFORM_WINDOWS
+#include "Windows.h"
+#elif defined( SLC_PLATFORM_LINUX )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+	using namespace slc;
+
+	// Mapping offsets must be a multiple of this.
+	static std::size_t GetMappingGranularity()
+	{
+#ifdef SLC_PLATFORM_WINDOWS
+		SYSTEM_INFO info;
+		GetSystemInfo( &info );
+		return static_cast< std::size_t >( info.dwAllocationGranularity );
+#elif defined( SLC_PLATFORM_LINUX )
+		return static_cast< std::size_t >( ::sysconf( _SC_PAGESIZE ) );
+#endif
+	}
+
+	static uint64_t AlignUp( uint64_t value, std::size_t alignment )
+	{
+		return ( value + alignment - 1 ) / alignment * alignment;
+	}
+} // namespace
+
+namespace slc {
+
+	MmapLogTarget::MmapLogTarget( const fs::path& path, LogLevel level, std::size_t segmentSize )
+		: ILogTarget( level )
+		, mSegmentSize( static_cast< std::size_t >( AlignUp( std::max< std::size_t >( segmentSize, 1 ), GetMappingGranularity() ) ) )
+	{
+		uint64_t size = 0;
+
+#ifdef SLC_PLATFORM_WINDOWS
+		mFile = CreateFileW( path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr );
+		if ( mFile == INVALID_HANDLE_VALUE )
+		{
+			mFile = nullptr;
+			return;
+		}
+
+		LARGE_INTEGER fileSize{};
+		GetFileSizeEx( mFile, &fileSize );
+		size = static_cast< uint64_t >( fileSize.QuadPart );
+#elif defined( SLC_PLATFORM_LINUX )
+		mFile = ::open( path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644 );
+		if ( mFile == -1 )
+			return;
+
+		struct stat info{};
+		if ( ::fstat( mFile, &info ) == 0 )
+			size = static_cast< uint64_t >( info.st_size );
+#endif
+
+		mDataEnd = size;
+
+		// Map the last segment's worth of an existing file so appending carries on where it left off.
+		const uint64_t start = size > mSegmentSize ? AlignUp( size - mSegmentSize, GetMappingGranularity() ) : 0;
+		if ( not MapSegment( start ) )
+			return;
+
+		// A file left behind by a crash ends in the unused, zero filled part of its last segment.
+		mCursor = static_cast< std::size_t >( size - start );
+		while ( mCursor > 0 and mSegment[ mCursor - 1 ] == Byte( 0 ) )
+			mCursor--;
+
+		mDataEnd = start + mCursor;
+	}
+
+	MmapLogTarget::~MmapLogTarget()
+	{
+		UnmapSegment();
+
+#ifdef SLC_PLATFORM_WINDOWS
+		if ( mFile )
+		{
+			LARGE_INTEGER end{};
+			end.QuadPart = static_cast< LONGLONG >( mDataEnd );
+			if ( SetFilePointerEx( mFile, end, nullptr, FILE_BEGIN ) )
+				SetEndOfFile( mFile );
+
+			CloseHandle( mFile );
+		}
+#elif defined( SLC_PLATFORM_LINUX )
+		if ( mFile != -1 )
+		{
+			::ftruncate( mFile, static_cast< off_t >( mDataEnd ) );
+			::close( mFile );
+		}
+#endif
+	}
+
+	void MmapLogTarget::DoWriteTarget()
+	{
+		SLC_PROFILE_FUNCTION();
+
+		for ( const LogFragment& fragment : mFragments )
+		{
+			auto data = static_cast< const Byte* >( fragment.iov_base );
+			std::size_t remaining = fragment.iov_len;
+
+			while ( remaining > 0 )
+			{
+				if ( not mSegment )
+					return;
+
+				if ( mCursor == mSegmentSize and not MapSegment( mSegmentOffset + mSegmentSize ) )
+					return;
+
+				const std::size_t count = std::min( remaining, mSegmentSize - mCursor );
+				std::memcpy( mSegment + mCursor, data, count );
+
+				mCursor += count;
+				mDataEnd += count;
+				data += count;
+				remaining -= count;
+			}
+		}
+	}
+
+	void MmapLogTarget::DoPreFlush()
+	{
+	}
+
+	void MmapLogTarget::DoFlush()
+	{
+		// Already in the page cache - the kernel writes it back.
+	}
+
+	bool MmapLogTarget::MapSegment( uint64_t offset )
+	{
+		SLC_PROFILE_FUNCTION();
+
+		UnmapSegment();
+
+		const uint64_t end = offset + mSegmentSize;
+
+#ifdef SLC_PLATFORM_WINDOWS
+		if ( not mFile )
+			return false;
+
+		// A mapping larger than the file grows the file to match.
+		mMapping = CreateFileMappingW( mFile, nullptr, PAGE_READWRITE, static_cast< DWORD >( end >> 32 ), static_cast< DWORD >( end ), nullptr );
+		if ( not mMapping )
+			return false;
+
+		mSegment = static_cast< Byte* >( MapViewOfFile( mMapping, FILE_MAP_WRITE, static_cast< DWORD >( offset >> 32 ), static_cast< DWORD >( offset ), mSegmentSize ) );
+#elif defined( SLC_PLATFORM_LINUX )
+		if ( mFile == -1 )
+			return false;
+
+		// Allocate the blocks up front. Running out of disk space under a plain ftruncate would only show up
+		// later, as SIGBUS on some write into the mapping.
+		if ( ::posix_fallocate( mFile, static_cast< off_t >( offset ), static_cast< off_t >( mSegmentSize ) ) != 0 )
+			return false;
+
+		void* segment = ::mmap( nullptr, mSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFile, static_cast< off_t >( offset ) );
+		if ( segment == MAP_FAILED )
+			return false;
+
+		::madvise( segment, mSegmentSize, MADV_SEQUENTIAL );
+		mSegment = static_cast< Byte* >( segment );
+#endif
+
+		mSegmentOffset = offset;
+		mCursor = 0;
+		return mSegment != nullptr;
+	}
+
+	void MmapLogTarget::UnmapSegment()
+	{
+#ifdef SLC_PLATFORM_WINDOWS
+		if ( mSegment )
+			UnmapViewOfFile( mSegment );
+
+		if ( mMapping )
+			CloseHandle( mMapping );
+
+		mMapping = nullptr;
+#elif defined( SLC_PLATFORM_LINUX )
+		if ( mSegment )
+			::munmap( mSegment, mSegmentSize );
+#endif
+
+		mSegment = nullptr;
+	}
+} // namespace slc
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ILogTarget.h"
+
+#include "slc/Common/Base.h"
+
+namespace slc {
+
+	/// <summary>
+	/// Log file written through a shared memory mapping. The file is grown one preallocated segment at a time
+	/// and messages are copied straight into the mapped pages, so a flush makes no syscalls at all; only moving
+	/// on to the next segment does. Written pages belong to the page cache as soon as they are copied, so the
+	/// log survives the process crashing, though not the machine losing power.
+	///
+	/// The file is truncated to the bytes actually written on close. After a crash it keeps the zero filled
+	/// tail of its last segment instead, which is found and skipped when the file is opened again.
+	/// </summary>
+	class MmapLogTarget : public ILogTarget
+	{
+	public:
+		SCONSTEXPR std::size_t DefaultSegmentSize = 64 * 1024 * 1024;
+
+		MmapLogTarget( const fs::path& path, LogLevel level = LogLevel::Debug, std::size_t segmentSize = DefaultSegmentSize );
+		~MmapLogTarget();
+
+		MmapLogTarget( const MmapLogTarget& ) = delete;
+		auto operator=( const MmapLogTarget& ) = delete;
+
+		bool IsOpen() const
+		{
+			return mSegment != nullptr;
+		}
+
+	private:
+		void DoWriteTarget() override;
+		void DoPreFlush() override;
+		void DoFlush() override;
+
+		bool MapSegment( uint64_t offset );
+		void UnmapSegment();
+
+	private:
+#ifdef SLC_PLATFORM_WINDOWS
+		void* mFile = nullptr;
+		void* mMapping = nullptr;
+#else
+		int mFile = -1;
+#endif
+
+		Byte* mSegment = nullptr;
+		std::size_t mSegmentSize;
+		// File offset of the mapped segment and the write position within it.
+		uint64_t mSegmentOffset = 0;
+		std::size_t mCursor = 0;
+
+		// End of the log data, which the file is truncated to on close. Kept apart from the mapping so a failed
+		// map never truncates the existing log.
+		uint64_t mDataEnd = 0;
+	};
+} // namespace slc
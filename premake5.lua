@@ -59,6 +59,7 @@ Library["SPIRV_Cross_GLSL_Release"] = "%{LibraryDir.VulkanSDK}/spirv-cross-glsl.
 
 include "StreamlineCore"
 include "TestApp"
+include "Benchmarks"
 
 group "Dependencies"
 